@@ -0,0 +1,255 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+namespace cpp_utils
+{
+    namespace details
+    {
+        inline constexpr std::string_view binary_fuse_magic{ "BFUSE8\x00\x01", 8 };
+        inline constexpr std::uint32_t max_binary_fuse_segment_length{ 1u << 18 };
+        inline constexpr std::size_t max_binary_fuse_attempts{ 100 };
+        struct binary_fuse_header final
+        {
+            std::array< char, 8 > magic;
+            std::uint64_t seed;
+            std::uint64_t num_of_keys;
+            std::uint32_t segment_length;
+            std::uint32_t segment_count;
+        };
+        static_assert( sizeof( binary_fuse_header ) == 32 );
+        struct binary_fuse_layout final
+        {
+            std::uint32_t segment_length;
+            std::uint32_t segment_length_mask;
+            std::uint32_t segment_count;
+            std::uint32_t segment_count_length;
+            std::uint32_t array_length;
+        };
+        inline auto make_binary_fuse_layout( const std::uint32_t segment_length, const std::uint32_t segment_count ) noexcept
+        {
+            return binary_fuse_layout{
+              segment_length, segment_length - 1, segment_count, segment_count * segment_length,
+              ( segment_count + 2 ) * segment_length };
+        }
+        inline auto plan_binary_fuse_layout( const std::size_t num_of_keys ) noexcept
+        {
+            const auto size{ static_cast< double >( num_of_keys ) };
+            const auto segment_length{
+              num_of_keys == 0
+                ? 4u
+                : std::ranges::min(
+                    1u << static_cast< int >( std::floor( std::log( size ) / std::log( 3.33 ) + 2.25 ) ),
+                    max_binary_fuse_segment_length ) };
+            const auto size_factor{
+              num_of_keys <= 1 ? 0.0 : std::ranges::max( 1.125, 0.875 + 0.25 * std::log( 1e6 ) / std::log( size ) ) };
+            const auto capacity{ num_of_keys <= 1 ? 0u : static_cast< std::uint32_t >( std::round( size * size_factor ) ) };
+            const auto initial_segment_count{ ( capacity + segment_length - 1 ) / segment_length - 2 };
+            const auto array_length{ ( initial_segment_count + 2 ) * segment_length };
+            const auto segment_count{ ( array_length + segment_length - 1 ) / segment_length };
+            return make_binary_fuse_layout( segment_length, segment_count <= 2 ? 1 : segment_count - 2 );
+        }
+        inline constexpr auto binary_fuse_mix( std::uint64_t key, const std::uint64_t seed ) noexcept
+        {
+            key += seed;
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccd;
+            key ^= key >> 33;
+            key *= 0xc4ceb9fe1a85ec53;
+            key ^= key >> 33;
+            return key;
+        }
+        inline constexpr auto binary_fuse_fingerprint( const std::uint64_t hash ) noexcept
+        {
+            return static_cast< std::uint8_t >( hash ^ ( hash >> 32 ) );
+        }
+        inline constexpr auto
+          binary_fuse_position( const binary_fuse_layout& layout, const std::uint64_t hash, const std::uint32_t index ) noexcept
+        {
+            const std::uint64_t segment_count_length{ layout.segment_count_length };
+            auto position{
+              ( ( hash >> 32 ) * segment_count_length + ( ( hash & 0xffff'ffffull ) * segment_count_length >> 32 ) ) >> 32 };
+            position += static_cast< std::uint64_t >( index ) * layout.segment_length;
+            const auto low_bits{ hash & ( ( 1ull << 36 ) - 1 ) };
+            position ^= ( low_bits >> ( 36 - 18 * index ) ) & layout.segment_length_mask;
+            return static_cast< std::uint32_t >( position );
+        }
+        inline constexpr auto binary_fuse_next_seed( std::uint64_t& state ) noexcept
+        {
+            state += 0x9e3779b97f4a7c15;
+            auto result{ state };
+            result = ( result ^ ( result >> 30 ) ) * 0xbf58476d1ce4e5b9;
+            result = ( result ^ ( result >> 27 ) ) * 0x94d049bb133111eb;
+            return result ^ ( result >> 31 );
+        }
+    }
+    class binary_fuse_filter final
+    {
+      private:
+        details::binary_fuse_layout layout_;
+        std::uint64_t seed_;
+        std::uint64_t num_of_keys_;
+        const std::uint8_t* fingerprints_;
+        binary_fuse_filter( const details::binary_fuse_header& header, const std::uint8_t* const fingerprints ) noexcept
+          : layout_{ details::make_binary_fuse_layout( header.segment_length, header.segment_count ) }
+          , seed_{ header.seed }
+          , num_of_keys_{ header.num_of_keys }
+          , fingerprints_{ fingerprints }
+        { }
+      public:
+        auto size() const noexcept
+        {
+            return num_of_keys_;
+        }
+        auto memory_size() const noexcept
+        {
+            return sizeof( details::binary_fuse_header ) + layout_.array_length;
+        }
+        auto contains( const std::uint64_t key ) const noexcept
+        {
+            const auto hash{ details::binary_fuse_mix( key, seed_ ) };
+            return ( details::binary_fuse_fingerprint( hash )
+                     ^ fingerprints_[ details::binary_fuse_position( layout_, hash, 0 ) ]
+                     ^ fingerprints_[ details::binary_fuse_position( layout_, hash, 1 ) ]
+                     ^ fingerprints_[ details::binary_fuse_position( layout_, hash, 2 ) ] )
+                == 0;
+        }
+        friend auto make_binary_fuse_filter( std::span< const char > data ) noexcept -> std::optional< binary_fuse_filter >;
+    };
+    inline auto make_binary_fuse_filter( const std::span< const char > data ) noexcept -> std::optional< binary_fuse_filter >
+    {
+        details::binary_fuse_header header;
+        if ( data.size() < sizeof( header ) ) {
+            return std::nullopt;
+        }
+        std::memcpy( &header, data.data(), sizeof( header ) );
+        if ( std::string_view{ header.magic.data(), header.magic.size() } != details::binary_fuse_magic
+             || !std::has_single_bit( header.segment_length )
+             || header.segment_length > details::max_binary_fuse_segment_length || header.segment_count == 0
+             || header.segment_count
+                  > std::numeric_limits< std::uint32_t >::max() / header.segment_length - 2 )
+        {
+            return std::nullopt;
+        }
+        const auto layout{ details::make_binary_fuse_layout( header.segment_length, header.segment_count ) };
+        if ( data.size() != sizeof( header ) + layout.array_length ) {
+            return std::nullopt;
+        }
+        return binary_fuse_filter{ header, reinterpret_cast< const std::uint8_t* >( data.data() + sizeof( header ) ) };
+    }
+    inline auto build_binary_fuse_filter( std::vector< std::uint64_t >& keys ) -> std::optional< std::vector< char > >
+    {
+        std::ranges::sort( keys );
+        keys.erase( std::ranges::unique( keys ).begin(), keys.end() );
+        if ( keys.size() > std::numeric_limits< std::uint32_t >::max() / 2 ) {
+            return std::nullopt;
+        }
+        const auto size{ keys.size() };
+        const auto layout{ details::plan_binary_fuse_layout( size ) };
+        const auto capacity{ static_cast< std::size_t >( layout.array_length ) };
+        std::uint32_t block_bits{ 1 };
+        while ( ( 1u << block_bits ) < layout.segment_count ) {
+            ++block_bits;
+        }
+        const auto num_of_blocks{ 1uz << block_bits };
+        std::vector< std::uint64_t > reverse_order( size + 1 );
+        std::vector< std::uint8_t > reverse_positions( size );
+        std::vector< std::uint32_t > alone( capacity );
+        std::vector< std::uint8_t > counts( capacity );
+        std::vector< std::uint64_t > hashes( capacity );
+        std::vector< std::uint32_t > start_positions( num_of_blocks );
+        std::uint64_t seed_state{ 0x726b2b9d438b9d4d };
+        std::uint64_t seed{ 0 };
+        auto is_built{ false };
+        for ( std::size_t attempt{ 0 }; !is_built && attempt < details::max_binary_fuse_attempts; ++attempt ) {
+            seed = details::binary_fuse_next_seed( seed_state );
+            std::ranges::fill( reverse_order, 0 );
+            std::ranges::fill( counts, 0 );
+            std::ranges::fill( hashes, 0 );
+            reverse_order[ size ] = 1;
+            for ( std::size_t i{ 0 }; i < num_of_blocks; ++i ) {
+                start_positions[ i ] = static_cast< std::uint32_t >( ( i * size ) >> block_bits );
+            }
+            for ( const auto key : keys ) {
+                const auto hash{ details::binary_fuse_mix( key, seed ) };
+                auto block{ hash >> ( 64 - block_bits ) };
+                while ( reverse_order[ start_positions[ block ] ] != 0 ) {
+                    block = ( block + 1 ) & ( num_of_blocks - 1 );
+                }
+                reverse_order[ start_positions[ block ]++ ] = hash;
+            }
+            auto has_overflow{ false };
+            for ( std::size_t i{ 0 }; i < size; ++i ) {
+                const auto hash{ reverse_order[ i ] };
+                for ( std::uint32_t index{ 0 }; index < 3; ++index ) {
+                    const auto position{ details::binary_fuse_position( layout, hash, index ) };
+                    counts[ position ] = static_cast< std::uint8_t >( ( counts[ position ] + 4 ) ^ index );
+                    hashes[ position ] ^= hash;
+                    has_overflow = has_overflow || counts[ position ] < 4;
+                }
+            }
+            if ( has_overflow ) {
+                continue;
+            }
+            std::size_t queue_size{ 0 };
+            for ( std::uint32_t i{ 0 }; i < capacity; ++i ) {
+                alone[ queue_size ] = i;
+                queue_size += ( counts[ i ] >> 2 ) == 1 ? 1 : 0;
+            }
+            std::size_t stack_size{ 0 };
+            while ( queue_size > 0 ) {
+                const auto position{ alone[ --queue_size ] };
+                if ( ( counts[ position ] >> 2 ) != 1 ) {
+                    continue;
+                }
+                const auto hash{ hashes[ position ] };
+                const auto found{ static_cast< std::uint8_t >( counts[ position ] & 3 ) };
+                reverse_positions[ stack_size ] = found;
+                reverse_order[ stack_size ]     = hash;
+                ++stack_size;
+                for ( std::uint32_t offset{ 1 }; offset < 3; ++offset ) {
+                    const auto index{ ( found + offset ) % 3 };
+                    const auto other{ details::binary_fuse_position( layout, hash, index ) };
+                    alone[ queue_size ] = other;
+                    queue_size += ( counts[ other ] >> 2 ) == 2 ? 1 : 0;
+                    counts[ other ] = static_cast< std::uint8_t >( ( counts[ other ] - 4 ) ^ index );
+                    hashes[ other ] ^= hash;
+                }
+            }
+            is_built = stack_size == size;
+        }
+        if ( !is_built ) {
+            return std::nullopt;
+        }
+        details::binary_fuse_header header{
+          .magic          = {},
+          .seed           = seed,
+          .num_of_keys    = size,
+          .segment_length = layout.segment_length,
+          .segment_count  = layout.segment_count };
+        std::ranges::copy( details::binary_fuse_magic, header.magic.begin() );
+        std::vector< char > result( sizeof( header ) + capacity );
+        std::memcpy( result.data(), &header, sizeof( header ) );
+        const auto fingerprints{ reinterpret_cast< std::uint8_t* >( result.data() + sizeof( header ) ) };
+        for ( auto i{ size }; i > 0; --i ) {
+            const auto hash{ reverse_order[ i - 1 ] };
+            const auto found{ reverse_positions[ i - 1 ] };
+            const std::array< std::uint32_t, 3 > positions{
+              details::binary_fuse_position( layout, hash, 0 ), details::binary_fuse_position( layout, hash, 1 ),
+              details::binary_fuse_position( layout, hash, 2 ) };
+            fingerprints[ positions[ found ] ] = static_cast< std::uint8_t >(
+              details::binary_fuse_fingerprint( hash ) ^ fingerprints[ positions[ ( found + 1 ) % 3 ] ]
+              ^ fingerprints[ positions[ ( found + 2 ) % 3 ] ] );
+        }
+        return result;
+    }
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <array>
 #include <concepts>
 #include <print>
+#include <utility>
 #include "compiler.hpp"
 namespace cpp_utils
 {
@@ -86,7 +87,9 @@ namespace cpp_utils
         auto operator=( basic_const_string< T, N >&& ) -> basic_const_string< T, N >&                = delete;
         consteval basic_const_string( const T ( &str )[ N + 1 ] ) noexcept
         {
-            static_assert( str[ N ] == '\0' );
+            if ( str[ N ] != '\0' ) {
+                std::unreachable();
+            }
             std::ranges::copy( str, storage_.data() );
         }
         consteval basic_const_string( const std::array< T, N > str ) noexcept
@@ -0,0 +1,29 @@
+#pragma once
+namespace cpp_utils
+{
+    struct cpu_features final
+    {
+        bool avx2{ false };
+        bool avx512f{ false };
+        bool avx512bw{ false };
+        bool avx512vbmi{ false };
+        bool avx512vbmi2{ false };
+    };
+    inline auto get_cpu_features() noexcept -> const cpu_features&
+    {
+        static const auto features{ [] noexcept
+        {
+            cpu_features result;
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+            __builtin_cpu_init();
+            result.avx2        = __builtin_cpu_supports( "avx2" );
+            result.avx512f     = __builtin_cpu_supports( "avx512f" );
+            result.avx512bw    = __builtin_cpu_supports( "avx512bw" );
+            result.avx512vbmi  = __builtin_cpu_supports( "avx512vbmi" );
+            result.avx512vbmi2 = __builtin_cpu_supports( "avx512vbmi2" );
+#endif
+            return result;
+        }() };
+        return features;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,704 @@
+#pragma once
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+# include <immintrin.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+#include "cpu.hpp"
+namespace cpp_utils
+{
+    enum class hash_algorithm : std::uint8_t
+    {
+        sha256,
+        blake3
+    };
+    inline constexpr std::size_t hash_digest_size{ 32 };
+    using hash_digest = std::array< std::byte, hash_digest_size >;
+    inline auto parse_hash_algorithm( const std::string_view name ) noexcept -> std::optional< hash_algorithm >
+    {
+        if ( name == "sha256" ) {
+            return hash_algorithm::sha256;
+        }
+        if ( name == "blake3" ) {
+            return hash_algorithm::blake3;
+        }
+        return std::nullopt;
+    }
+    inline auto hash_algorithm_name( const hash_algorithm algorithm ) noexcept -> std::string_view
+    {
+        return algorithm == hash_algorithm::sha256 ? "sha256" : "blake3";
+    }
+    namespace details
+    {
+        inline constexpr std::size_t hash_block_size{ 64 };
+        inline constexpr std::size_t max_hash_lanes{ 16 };
+        using hash_kernel_t = void ( * )( const char* const*, const std::size_t*, std::size_t, std::byte* ) noexcept;
+        struct hash_kernel final
+        {
+            hash_kernel_t function;
+            std::size_t lanes;
+        };
+        inline constexpr std::array< std::uint32_t, 8 > hash_initial_state{
+          0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+        inline constexpr std::array< std::uint32_t, 64 > sha256_round_constants{
+          0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+          0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+          0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+          0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+          0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+          0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+          0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+          0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+        inline constexpr std::size_t blake3_chunk_size{ 1024 };
+        inline constexpr std::uint32_t blake3_chunk_start{ 1 };
+        inline constexpr std::uint32_t blake3_chunk_end{ 2 };
+        inline constexpr std::uint32_t blake3_parent{ 4 };
+        inline constexpr std::uint32_t blake3_root{ 8 };
+        inline constexpr auto blake3_schedule{ [] consteval
+        {
+            constexpr std::array< std::uint8_t, 16 > permutation{ 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 };
+            std::array< std::array< std::uint8_t, 16 >, 7 > result{};
+            for ( std::uint8_t i{ 0 }; i < 16; ++i ) {
+                result[ 0 ][ i ] = i;
+            }
+            for ( std::size_t round{ 1 }; round < result.size(); ++round ) {
+                for ( std::size_t i{ 0 }; i < 16; ++i ) {
+                    result[ round ][ i ] = result[ round - 1 ][ permutation[ i ] ];
+                }
+            }
+            return result;
+        }() };
+        inline auto load_word( const std::byte* const bytes ) noexcept
+        {
+            std::uint32_t word;
+            std::memcpy( &word, bytes, sizeof( word ) );
+            return word;
+        }
+        inline auto store_word( std::byte* const bytes, const std::uint32_t word ) noexcept
+        {
+            std::memcpy( bytes, &word, sizeof( word ) );
+        }
+        inline auto copy_message_block(
+          const char* const message, const std::size_t size, const std::size_t index, std::byte* const block ) noexcept
+        {
+            const auto offset{ index * hash_block_size };
+            const auto copied{ offset < size ? std::ranges::min( size - offset, hash_block_size ) : 0uz };
+            if ( copied != 0 ) {
+                std::memcpy( block, message + offset, copied );
+            }
+            std::memset( block + copied, 0, hash_block_size - copied );
+        }
+        template < typename BlockMaker >
+        inline auto gather_message_words(
+          const std::size_t count, const std::size_t lanes, std::uint32_t* const words, BlockMaker&& make_block ) noexcept
+        {
+            alignas( 64 ) std::array< std::byte, hash_block_size > block{};
+            for ( std::size_t lane{ 0 }; lane < lanes; ++lane ) {
+                if ( lane < count ) {
+                    make_block( lane, block.data() );
+                }
+                for ( std::size_t i{ 0 }; i < 16; ++i ) {
+                    words[ i * lanes + lane ] = load_word( block.data() + i * sizeof( std::uint32_t ) );
+                }
+            }
+        }
+        inline auto scatter_digest_words(
+          const std::uint32_t* const words, const std::size_t count, const std::size_t lanes, const bool big_endian,
+          std::byte* const digests ) noexcept
+        {
+            for ( std::size_t lane{ 0 }; lane < count; ++lane ) {
+                for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                    const auto word{ words[ i * lanes + lane ] };
+                    store_word(
+                      digests + lane * hash_digest_size + i * sizeof( word ), big_endian ? std::byteswap( word ) : word );
+                }
+            }
+        }
+        inline constexpr auto sha256_block_count( const std::size_t size ) noexcept
+        {
+            return ( size + 9 + hash_block_size - 1 ) / hash_block_size;
+        }
+        inline auto sha256_message_block(
+          const char* const message, const std::size_t size, const std::size_t index, std::byte* const block ) noexcept
+        {
+            copy_message_block( message, size, index, block );
+            const auto offset{ index * hash_block_size };
+            if ( size >= offset && size < offset + hash_block_size ) {
+                block[ size - offset ] = std::byte{ 0x80 };
+            }
+            if ( index + 1 == sha256_block_count( size ) ) {
+                const auto bits{ std::byteswap( static_cast< std::uint64_t >( size ) * 8 ) };
+                std::memcpy( block + hash_block_size - sizeof( bits ), &bits, sizeof( bits ) );
+            }
+        }
+        inline auto sha256_compress_scalar( std::array< std::uint32_t, 8 >& state, const std::byte* const block ) noexcept
+        {
+            std::array< std::uint32_t, 64 > w;
+            for ( std::size_t i{ 0 }; i < 16; ++i ) {
+                w[ i ] = std::byteswap( load_word( block + i * sizeof( std::uint32_t ) ) );
+            }
+            for ( std::size_t i{ 16 }; i < w.size(); ++i ) {
+                const auto s0{ std::rotr( w[ i - 15 ], 7 ) ^ std::rotr( w[ i - 15 ], 18 ) ^ ( w[ i - 15 ] >> 3 ) };
+                const auto s1{ std::rotr( w[ i - 2 ], 17 ) ^ std::rotr( w[ i - 2 ], 19 ) ^ ( w[ i - 2 ] >> 10 ) };
+                w[ i ] = w[ i - 16 ] + s0 + w[ i - 7 ] + s1;
+            }
+            auto [ a, b, c, d, e, f, g, h ]{ state };
+            for ( std::size_t i{ 0 }; i < w.size(); ++i ) {
+                const auto s1{ std::rotr( e, 6 ) ^ std::rotr( e, 11 ) ^ std::rotr( e, 25 ) };
+                const auto t1{ h + s1 + ( ( e & f ) ^ ( ~e & g ) ) + sha256_round_constants[ i ] + w[ i ] };
+                const auto s0{ std::rotr( a, 2 ) ^ std::rotr( a, 13 ) ^ std::rotr( a, 22 ) };
+                const auto t2{ s0 + ( ( a & b ) | ( c & ( a | b ) ) ) };
+                h = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+            const std::array< std::uint32_t, 8 > result{ a, b, c, d, e, f, g, h };
+            for ( std::size_t i{ 0 }; i < state.size(); ++i ) {
+                state[ i ] += result[ i ];
+            }
+        }
+        inline auto sha256_scalar(
+          const char* const* const messages, const std::size_t* const sizes, const std::size_t count,
+          std::byte* const digests ) noexcept
+        {
+            alignas( 64 ) std::array< std::byte, hash_block_size > block;
+            for ( std::size_t i{ 0 }; i < count; ++i ) {
+                auto state{ hash_initial_state };
+                const auto num_of_blocks{ sha256_block_count( sizes[ i ] ) };
+                for ( std::size_t index{ 0 }; index < num_of_blocks; ++index ) {
+                    sha256_message_block( messages[ i ], sizes[ i ], index, block.data() );
+                    sha256_compress_scalar( state, block.data() );
+                }
+                scatter_digest_words( state.data(), 1, 1, true, digests + i * hash_digest_size );
+            }
+        }
+        inline auto blake3_g(
+          std::array< std::uint32_t, 16 >& v, const std::size_t a, const std::size_t b, const std::size_t c,
+          const std::size_t d, const std::uint32_t x, const std::uint32_t y ) noexcept
+        {
+            v[ a ] += v[ b ] + x;
+            v[ d ] = std::rotr( v[ d ] ^ v[ a ], 16 );
+            v[ c ] += v[ d ];
+            v[ b ] = std::rotr( v[ b ] ^ v[ c ], 12 );
+            v[ a ] += v[ b ] + y;
+            v[ d ] = std::rotr( v[ d ] ^ v[ a ], 8 );
+            v[ c ] += v[ d ];
+            v[ b ] = std::rotr( v[ b ] ^ v[ c ], 7 );
+        }
+        inline auto blake3_compress(
+          const std::array< std::uint32_t, 8 >& chaining_value, const std::uint32_t* const m, const std::uint64_t counter,
+          const std::uint32_t block_size, const std::uint32_t flags ) noexcept
+        {
+            std::array< std::uint32_t, 16 > v{
+              chaining_value[ 0 ],
+              chaining_value[ 1 ],
+              chaining_value[ 2 ],
+              chaining_value[ 3 ],
+              chaining_value[ 4 ],
+              chaining_value[ 5 ],
+              chaining_value[ 6 ],
+              chaining_value[ 7 ],
+              hash_initial_state[ 0 ],
+              hash_initial_state[ 1 ],
+              hash_initial_state[ 2 ],
+              hash_initial_state[ 3 ],
+              static_cast< std::uint32_t >( counter ),
+              static_cast< std::uint32_t >( counter >> 32 ),
+              block_size,
+              flags };
+            for ( const auto& s : blake3_schedule ) {
+                blake3_g( v, 0, 4, 8, 12, m[ s[ 0 ] ], m[ s[ 1 ] ] );
+                blake3_g( v, 1, 5, 9, 13, m[ s[ 2 ] ], m[ s[ 3 ] ] );
+                blake3_g( v, 2, 6, 10, 14, m[ s[ 4 ] ], m[ s[ 5 ] ] );
+                blake3_g( v, 3, 7, 11, 15, m[ s[ 6 ] ], m[ s[ 7 ] ] );
+                blake3_g( v, 0, 5, 10, 15, m[ s[ 8 ] ], m[ s[ 9 ] ] );
+                blake3_g( v, 1, 6, 11, 12, m[ s[ 10 ] ], m[ s[ 11 ] ] );
+                blake3_g( v, 2, 7, 8, 13, m[ s[ 12 ] ], m[ s[ 13 ] ] );
+                blake3_g( v, 3, 4, 9, 14, m[ s[ 14 ] ], m[ s[ 15 ] ] );
+            }
+            std::array< std::uint32_t, 8 > result;
+            for ( std::size_t i{ 0 }; i < result.size(); ++i ) {
+                result[ i ] = v[ i ] ^ v[ i + 8 ];
+            }
+            return result;
+        }
+        inline constexpr auto blake3_block_count( const std::size_t size ) noexcept
+        {
+            return std::ranges::max( ( size + hash_block_size - 1 ) / hash_block_size, 1uz );
+        }
+        inline constexpr auto
+          blake3_block_flags( const std::size_t size, const std::size_t index, const std::uint32_t root ) noexcept
+        {
+            return ( index == 0 ? blake3_chunk_start : 0 )
+                 | ( index + 1 == blake3_block_count( size ) ? blake3_chunk_end | root : 0 );
+        }
+        inline constexpr auto blake3_block_size( const std::size_t size, const std::size_t index ) noexcept
+        {
+            const auto offset{ std::ranges::min( size, index * hash_block_size ) };
+            return static_cast< std::uint32_t >( std::ranges::min( size - offset, hash_block_size ) );
+        }
+        inline auto blake3_subtree(
+          const char* const data, const std::size_t size, const std::uint64_t chunk_counter, const std::uint32_t root ) noexcept
+          -> std::array< std::uint32_t, 8 >
+        {
+            alignas( 64 ) std::array< std::byte, hash_block_size > block;
+            std::array< std::uint32_t, 16 > words;
+            if ( size <= blake3_chunk_size ) {
+                auto chaining_value{ hash_initial_state };
+                const auto num_of_blocks{ blake3_block_count( size ) };
+                for ( std::size_t index{ 0 }; index < num_of_blocks; ++index ) {
+                    copy_message_block( data, size, index, block.data() );
+                    std::memcpy( words.data(), block.data(), block.size() );
+                    chaining_value = blake3_compress(
+                      chaining_value, words.data(), chunk_counter, blake3_block_size( size, index ),
+                      blake3_block_flags( size, index, root ) );
+                }
+                return chaining_value;
+            }
+            const auto left_chunks{ std::bit_floor( ( size - 1 ) / blake3_chunk_size ) };
+            const auto left_size{ left_chunks * blake3_chunk_size };
+            const auto left{ blake3_subtree( data, left_size, chunk_counter, 0 ) };
+            const auto right{ blake3_subtree( data + left_size, size - left_size, chunk_counter + left_chunks, 0 ) };
+            std::ranges::copy( left, words.begin() );
+            std::ranges::copy( right, words.begin() + left.size() );
+            return blake3_compress(
+              hash_initial_state, words.data(), 0, static_cast< std::uint32_t >( hash_block_size ), blake3_parent | root );
+        }
+        inline auto blake3_scalar(
+          const char* const* const messages, const std::size_t* const sizes, const std::size_t count,
+          std::byte* const digests ) noexcept
+        {
+            for ( std::size_t i{ 0 }; i < count; ++i ) {
+                const auto chaining_value{ blake3_subtree( messages[ i ], sizes[ i ], 0, blake3_root ) };
+                scatter_digest_words( chaining_value.data(), 1, 1, false, digests + i * hash_digest_size );
+            }
+        }
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+        [[gnu::target( "avx2" )]] inline auto hash_rotr_avx2( const __m256i v, const int n ) noexcept
+        {
+            return _mm256_or_si256( _mm256_srli_epi32( v, n ), _mm256_slli_epi32( v, 32 - n ) );
+        }
+        [[gnu::target( "avx2" )]] inline auto
+          sha256_compress_avx2( __m256i* const state, const std::uint32_t* const words, const __m256i active ) noexcept
+        {
+            const auto byteswap{ _mm256_setr_epi8(
+              3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 ) };
+            __m256i w[ 16 ];
+            for ( std::size_t i{ 0 }; i < 16; ++i ) {
+                w[ i ] = _mm256_shuffle_epi8(
+                  _mm256_load_si256( reinterpret_cast< const __m256i* >( words + i * 8 ) ), byteswap );
+            }
+            auto a{ state[ 0 ] };
+            auto b{ state[ 1 ] };
+            auto c{ state[ 2 ] };
+            auto d{ state[ 3 ] };
+            auto e{ state[ 4 ] };
+            auto f{ state[ 5 ] };
+            auto g{ state[ 6 ] };
+            auto h{ state[ 7 ] };
+            for ( std::size_t i{ 0 }; i < sha256_round_constants.size(); ++i ) {
+                if ( i >= 16 ) {
+                    const auto w15{ w[ ( i + 1 ) % 16 ] };
+                    const auto w2{ w[ ( i + 14 ) % 16 ] };
+                    const auto s0{ _mm256_xor_si256(
+                      _mm256_xor_si256( hash_rotr_avx2( w15, 7 ), hash_rotr_avx2( w15, 18 ) ), _mm256_srli_epi32( w15, 3 ) ) };
+                    const auto s1{ _mm256_xor_si256(
+                      _mm256_xor_si256( hash_rotr_avx2( w2, 17 ), hash_rotr_avx2( w2, 19 ) ), _mm256_srli_epi32( w2, 10 ) ) };
+                    w[ i % 16 ] = _mm256_add_epi32(
+                      _mm256_add_epi32( w[ i % 16 ], s0 ), _mm256_add_epi32( w[ ( i + 9 ) % 16 ], s1 ) );
+                }
+                const auto s1{ _mm256_xor_si256(
+                  _mm256_xor_si256( hash_rotr_avx2( e, 6 ), hash_rotr_avx2( e, 11 ) ), hash_rotr_avx2( e, 25 ) ) };
+                const auto choice{ _mm256_xor_si256( _mm256_and_si256( e, f ), _mm256_andnot_si256( e, g ) ) };
+                const auto t1{ _mm256_add_epi32(
+                  _mm256_add_epi32( _mm256_add_epi32( h, s1 ), _mm256_add_epi32( choice, w[ i % 16 ] ) ),
+                  _mm256_set1_epi32( static_cast< int >( sha256_round_constants[ i ] ) ) ) };
+                const auto s0{ _mm256_xor_si256(
+                  _mm256_xor_si256( hash_rotr_avx2( a, 2 ), hash_rotr_avx2( a, 13 ) ), hash_rotr_avx2( a, 22 ) ) };
+                const auto majority{
+                  _mm256_or_si256( _mm256_and_si256( a, b ), _mm256_and_si256( c, _mm256_or_si256( a, b ) ) ) };
+                h = g;
+                g = f;
+                f = e;
+                e = _mm256_add_epi32( d, t1 );
+                d = c;
+                c = b;
+                b = a;
+                a = _mm256_add_epi32( t1, _mm256_add_epi32( s0, majority ) );
+            }
+            const __m256i result[ 8 ]{ a, b, c, d, e, f, g, h };
+            for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                state[ i ] = _mm256_blendv_epi8( state[ i ], _mm256_add_epi32( state[ i ], result[ i ] ), active );
+            }
+        }
+        [[gnu::target( "avx2" )]] inline auto sha256_avx2(
+          const char* const* const messages, const std::size_t* const sizes, const std::size_t count,
+          std::byte* const digests ) noexcept
+        {
+            constexpr std::size_t lanes{ 8 };
+            alignas( 32 ) std::array< std::uint32_t, lanes > block_counts{};
+            for ( std::size_t i{ 0 }; i < count; ++i ) {
+                block_counts[ i ] = static_cast< std::uint32_t >( sha256_block_count( sizes[ i ] ) );
+            }
+            const auto counts{ _mm256_load_si256( reinterpret_cast< const __m256i* >( block_counts.data() ) ) };
+            __m256i state[ 8 ];
+            for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                state[ i ] = _mm256_set1_epi32( static_cast< int >( hash_initial_state[ i ] ) );
+            }
+            alignas( 32 ) std::array< std::uint32_t, 16 * lanes > words;
+            const auto num_of_blocks{ std::ranges::max( block_counts ) };
+            for ( std::uint32_t index{ 0 }; index < num_of_blocks; ++index ) {
+                gather_message_words(
+                  count, lanes, words.data(), [ & ]( const std::size_t lane, std::byte* const block ) noexcept
+                {
+                    sha256_message_block( messages[ lane ], sizes[ lane ], index, block );
+                } );
+                sha256_compress_avx2(
+                  state, words.data(), _mm256_cmpgt_epi32( counts, _mm256_set1_epi32( static_cast< int >( index ) ) ) );
+            }
+            alignas( 32 ) std::array< std::uint32_t, 8 * lanes > result;
+            for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                _mm256_store_si256( reinterpret_cast< __m256i* >( result.data() + i * lanes ), state[ i ] );
+            }
+            scatter_digest_words( result.data(), count, lanes, true, digests );
+        }
+        [[gnu::target( "avx512f,avx512bw" )]] inline auto
+          sha256_compress_avx512( __m512i* const state, const std::uint32_t* const words, const __mmask16 active ) noexcept
+        {
+            const auto byteswap{
+              _mm512_broadcast_i32x4( _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 ) ) };
+            __m512i w[ 16 ];
+            for ( std::size_t i{ 0 }; i < 16; ++i ) {
+                w[ i ] = _mm512_shuffle_epi8( _mm512_load_si512( words + i * 16 ), byteswap );
+            }
+            auto a{ state[ 0 ] };
+            auto b{ state[ 1 ] };
+            auto c{ state[ 2 ] };
+            auto d{ state[ 3 ] };
+            auto e{ state[ 4 ] };
+            auto f{ state[ 5 ] };
+            auto g{ state[ 6 ] };
+            auto h{ state[ 7 ] };
+            for ( std::size_t i{ 0 }; i < sha256_round_constants.size(); ++i ) {
+                if ( i >= 16 ) {
+                    const auto w15{ w[ ( i + 1 ) % 16 ] };
+                    const auto w2{ w[ ( i + 14 ) % 16 ] };
+                    const auto s0{ _mm512_ternarylogic_epi32(
+                      _mm512_ror_epi32( w15, 7 ), _mm512_ror_epi32( w15, 18 ), _mm512_srli_epi32( w15, 3 ), 0x96 ) };
+                    const auto s1{ _mm512_ternarylogic_epi32(
+                      _mm512_ror_epi32( w2, 17 ), _mm512_ror_epi32( w2, 19 ), _mm512_srli_epi32( w2, 10 ), 0x96 ) };
+                    w[ i % 16 ] = _mm512_add_epi32(
+                      _mm512_add_epi32( w[ i % 16 ], s0 ), _mm512_add_epi32( w[ ( i + 9 ) % 16 ], s1 ) );
+                }
+                const auto s1{ _mm512_ternarylogic_epi32(
+                  _mm512_ror_epi32( e, 6 ), _mm512_ror_epi32( e, 11 ), _mm512_ror_epi32( e, 25 ), 0x96 ) };
+                const auto choice{ _mm512_ternarylogic_epi32( e, f, g, 0xca ) };
+                const auto t1{ _mm512_add_epi32(
+                  _mm512_add_epi32( _mm512_add_epi32( h, s1 ), _mm512_add_epi32( choice, w[ i % 16 ] ) ),
+                  _mm512_set1_epi32( static_cast< int >( sha256_round_constants[ i ] ) ) ) };
+                const auto s0{ _mm512_ternarylogic_epi32(
+                  _mm512_ror_epi32( a, 2 ), _mm512_ror_epi32( a, 13 ), _mm512_ror_epi32( a, 22 ), 0x96 ) };
+                h = g;
+                g = f;
+                f = e;
+                e = _mm512_add_epi32( d, t1 );
+                d = c;
+                c = b;
+                b = a;
+                a = _mm512_add_epi32( t1, _mm512_add_epi32( s0, _mm512_ternarylogic_epi32( b, c, d, 0xe8 ) ) );
+            }
+            const __m512i result[ 8 ]{ a, b, c, d, e, f, g, h };
+            for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                state[ i ] = _mm512_mask_add_epi32( state[ i ], active, state[ i ], result[ i ] );
+            }
+        }
+        [[gnu::target( "avx512f,avx512bw" )]] inline auto sha256_avx512(
+          const char* const* const messages, const std::size_t* const sizes, const std::size_t count,
+          std::byte* const digests ) noexcept
+        {
+            constexpr std::size_t lanes{ 16 };
+            alignas( 64 ) std::array< std::uint32_t, lanes > block_counts{};
+            for ( std::size_t i{ 0 }; i < count; ++i ) {
+                block_counts[ i ] = static_cast< std::uint32_t >( sha256_block_count( sizes[ i ] ) );
+            }
+            const auto counts{ _mm512_load_si512( block_counts.data() ) };
+            __m512i state[ 8 ];
+            for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                state[ i ] = _mm512_set1_epi32( static_cast< int >( hash_initial_state[ i ] ) );
+            }
+            alignas( 64 ) std::array< std::uint32_t, 16 * lanes > words;
+            const auto num_of_blocks{ std::ranges::max( block_counts ) };
+            for ( std::uint32_t index{ 0 }; index < num_of_blocks; ++index ) {
+                gather_message_words(
+                  count, lanes, words.data(), [ & ]( const std::size_t lane, std::byte* const block ) noexcept
+                {
+                    sha256_message_block( messages[ lane ], sizes[ lane ], index, block );
+                } );
+                sha256_compress_avx512(
+                  state, words.data(), _mm512_cmpgt_epu32_mask( counts, _mm512_set1_epi32( static_cast< int >( index ) ) ) );
+            }
+            alignas( 64 ) std::array< std::uint32_t, 8 * lanes > result;
+            for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                _mm512_store_si512( result.data() + i * lanes, state[ i ] );
+            }
+            scatter_digest_words( result.data(), count, lanes, true, digests );
+        }
+        [[gnu::target( "avx2" )]] inline auto blake3_g_avx2(
+          __m256i* const v, const std::size_t a, const std::size_t b, const std::size_t c, const std::size_t d,
+          const __m256i x, const __m256i y ) noexcept
+        {
+            const auto rot16{ _mm256_setr_epi8(
+              2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13 ) };
+            const auto rot8{ _mm256_setr_epi8(
+              1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12 ) };
+            v[ a ] = _mm256_add_epi32( _mm256_add_epi32( v[ a ], v[ b ] ), x );
+            v[ d ] = _mm256_shuffle_epi8( _mm256_xor_si256( v[ d ], v[ a ] ), rot16 );
+            v[ c ] = _mm256_add_epi32( v[ c ], v[ d ] );
+            v[ b ] = hash_rotr_avx2( _mm256_xor_si256( v[ b ], v[ c ] ), 12 );
+            v[ a ] = _mm256_add_epi32( _mm256_add_epi32( v[ a ], v[ b ] ), y );
+            v[ d ] = _mm256_shuffle_epi8( _mm256_xor_si256( v[ d ], v[ a ] ), rot8 );
+            v[ c ] = _mm256_add_epi32( v[ c ], v[ d ] );
+            v[ b ] = hash_rotr_avx2( _mm256_xor_si256( v[ b ], v[ c ] ), 7 );
+        }
+        [[gnu::target( "avx2" )]] inline auto blake3_avx2(
+          const char* const* const messages, const std::size_t* const sizes, const std::size_t count,
+          std::byte* const digests ) noexcept
+        {
+            constexpr std::size_t lanes{ 8 };
+            if ( std::ranges::any_of(
+                   sizes, sizes + count, []( const std::size_t size ) noexcept { return size > blake3_chunk_size; } ) )
+            {
+                blake3_scalar( messages, sizes, count, digests );
+                return;
+            }
+            __m256i chaining_value[ 8 ];
+            for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                chaining_value[ i ] = _mm256_set1_epi32( static_cast< int >( hash_initial_state[ i ] ) );
+            }
+            alignas( 32 ) std::array< std::uint32_t, 16 * lanes > words;
+            alignas( 32 ) std::array< std::uint32_t, lanes > block_sizes;
+            alignas( 32 ) std::array< std::uint32_t, lanes > block_flags;
+            alignas( 32 ) std::array< std::uint32_t, lanes > block_counts{};
+            for ( std::size_t i{ 0 }; i < count; ++i ) {
+                block_counts[ i ] = static_cast< std::uint32_t >( blake3_block_count( sizes[ i ] ) );
+            }
+            const auto counts{ _mm256_load_si256( reinterpret_cast< const __m256i* >( block_counts.data() ) ) };
+            const auto num_of_blocks{ std::ranges::max( block_counts ) };
+            for ( std::uint32_t index{ 0 }; index < num_of_blocks; ++index ) {
+                gather_message_words(
+                  count, lanes, words.data(), [ & ]( const std::size_t lane, std::byte* const block ) noexcept
+                {
+                    copy_message_block( messages[ lane ], sizes[ lane ], index, block );
+                } );
+                for ( std::size_t lane{ 0 }; lane < lanes; ++lane ) {
+                    const auto size{ lane < count ? sizes[ lane ] : 0 };
+                    block_sizes[ lane ] = blake3_block_size( size, index );
+                    block_flags[ lane ] = blake3_block_flags( size, index, blake3_root );
+                }
+                __m256i m[ 16 ];
+                for ( std::size_t i{ 0 }; i < 16; ++i ) {
+                    m[ i ] = _mm256_load_si256( reinterpret_cast< const __m256i* >( words.data() + i * lanes ) );
+                }
+                __m256i v[ 16 ]{
+                  chaining_value[ 0 ],
+                  chaining_value[ 1 ],
+                  chaining_value[ 2 ],
+                  chaining_value[ 3 ],
+                  chaining_value[ 4 ],
+                  chaining_value[ 5 ],
+                  chaining_value[ 6 ],
+                  chaining_value[ 7 ],
+                  _mm256_set1_epi32( static_cast< int >( hash_initial_state[ 0 ] ) ),
+                  _mm256_set1_epi32( static_cast< int >( hash_initial_state[ 1 ] ) ),
+                  _mm256_set1_epi32( static_cast< int >( hash_initial_state[ 2 ] ) ),
+                  _mm256_set1_epi32( static_cast< int >( hash_initial_state[ 3 ] ) ),
+                  _mm256_setzero_si256(),
+                  _mm256_setzero_si256(),
+                  _mm256_load_si256( reinterpret_cast< const __m256i* >( block_sizes.data() ) ),
+                  _mm256_load_si256( reinterpret_cast< const __m256i* >( block_flags.data() ) ) };
+                for ( const auto& s : blake3_schedule ) {
+                    blake3_g_avx2( v, 0, 4, 8, 12, m[ s[ 0 ] ], m[ s[ 1 ] ] );
+                    blake3_g_avx2( v, 1, 5, 9, 13, m[ s[ 2 ] ], m[ s[ 3 ] ] );
+                    blake3_g_avx2( v, 2, 6, 10, 14, m[ s[ 4 ] ], m[ s[ 5 ] ] );
+                    blake3_g_avx2( v, 3, 7, 11, 15, m[ s[ 6 ] ], m[ s[ 7 ] ] );
+                    blake3_g_avx2( v, 0, 5, 10, 15, m[ s[ 8 ] ], m[ s[ 9 ] ] );
+                    blake3_g_avx2( v, 1, 6, 11, 12, m[ s[ 10 ] ], m[ s[ 11 ] ] );
+                    blake3_g_avx2( v, 2, 7, 8, 13, m[ s[ 12 ] ], m[ s[ 13 ] ] );
+                    blake3_g_avx2( v, 3, 4, 9, 14, m[ s[ 14 ] ], m[ s[ 15 ] ] );
+                }
+                const auto active{ _mm256_cmpgt_epi32( counts, _mm256_set1_epi32( static_cast< int >( index ) ) ) };
+                for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                    chaining_value[ i ]
+                      = _mm256_blendv_epi8( chaining_value[ i ], _mm256_xor_si256( v[ i ], v[ i + 8 ] ), active );
+                }
+            }
+            alignas( 32 ) std::array< std::uint32_t, 8 * lanes > result;
+            for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                _mm256_store_si256( reinterpret_cast< __m256i* >( result.data() + i * lanes ), chaining_value[ i ] );
+            }
+            scatter_digest_words( result.data(), count, lanes, false, digests );
+        }
+        [[gnu::target( "avx512f" )]] inline auto blake3_g_avx512(
+          __m512i* const v, const std::size_t a, const std::size_t b, const std::size_t c, const std::size_t d,
+          const __m512i x, const __m512i y ) noexcept
+        {
+            v[ a ] = _mm512_add_epi32( _mm512_add_epi32( v[ a ], v[ b ] ), x );
+            v[ d ] = _mm512_ror_epi32( _mm512_xor_si512( v[ d ], v[ a ] ), 16 );
+            v[ c ] = _mm512_add_epi32( v[ c ], v[ d ] );
+            v[ b ] = _mm512_ror_epi32( _mm512_xor_si512( v[ b ], v[ c ] ), 12 );
+            v[ a ] = _mm512_add_epi32( _mm512_add_epi32( v[ a ], v[ b ] ), y );
+            v[ d ] = _mm512_ror_epi32( _mm512_xor_si512( v[ d ], v[ a ] ), 8 );
+            v[ c ] = _mm512_add_epi32( v[ c ], v[ d ] );
+            v[ b ] = _mm512_ror_epi32( _mm512_xor_si512( v[ b ], v[ c ] ), 7 );
+        }
+        [[gnu::target( "avx512f" )]] inline auto blake3_avx512(
+          const char* const* const messages, const std::size_t* const sizes, const std::size_t count,
+          std::byte* const digests ) noexcept
+        {
+            constexpr std::size_t lanes{ 16 };
+            if ( std::ranges::any_of(
+                   sizes, sizes + count, []( const std::size_t size ) noexcept { return size > blake3_chunk_size; } ) )
+            {
+                blake3_scalar( messages, sizes, count, digests );
+                return;
+            }
+            __m512i chaining_value[ 8 ];
+            for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                chaining_value[ i ] = _mm512_set1_epi32( static_cast< int >( hash_initial_state[ i ] ) );
+            }
+            alignas( 64 ) std::array< std::uint32_t, 16 * lanes > words;
+            alignas( 64 ) std::array< std::uint32_t, lanes > block_sizes;
+            alignas( 64 ) std::array< std::uint32_t, lanes > block_flags;
+            alignas( 64 ) std::array< std::uint32_t, lanes > block_counts{};
+            for ( std::size_t i{ 0 }; i < count; ++i ) {
+                block_counts[ i ] = static_cast< std::uint32_t >( blake3_block_count( sizes[ i ] ) );
+            }
+            const auto counts{ _mm512_load_si512( block_counts.data() ) };
+            const auto num_of_blocks{ std::ranges::max( block_counts ) };
+            for ( std::uint32_t index{ 0 }; index < num_of_blocks; ++index ) {
+                gather_message_words(
+                  count, lanes, words.data(), [ & ]( const std::size_t lane, std::byte* const block ) noexcept
+                {
+                    copy_message_block( messages[ lane ], sizes[ lane ], index, block );
+                } );
+                for ( std::size_t lane{ 0 }; lane < lanes; ++lane ) {
+                    const auto size{ lane < count ? sizes[ lane ] : 0 };
+                    block_sizes[ lane ] = blake3_block_size( size, index );
+                    block_flags[ lane ] = blake3_block_flags( size, index, blake3_root );
+                }
+                __m512i m[ 16 ];
+                for ( std::size_t i{ 0 }; i < 16; ++i ) {
+                    m[ i ] = _mm512_load_si512( words.data() + i * lanes );
+                }
+                __m512i v[ 16 ]{
+                  chaining_value[ 0 ],
+                  chaining_value[ 1 ],
+                  chaining_value[ 2 ],
+                  chaining_value[ 3 ],
+                  chaining_value[ 4 ],
+                  chaining_value[ 5 ],
+                  chaining_value[ 6 ],
+                  chaining_value[ 7 ],
+                  _mm512_set1_epi32( static_cast< int >( hash_initial_state[ 0 ] ) ),
+                  _mm512_set1_epi32( static_cast< int >( hash_initial_state[ 1 ] ) ),
+                  _mm512_set1_epi32( static_cast< int >( hash_initial_state[ 2 ] ) ),
+                  _mm512_set1_epi32( static_cast< int >( hash_initial_state[ 3 ] ) ),
+                  _mm512_setzero_si512(),
+                  _mm512_setzero_si512(),
+                  _mm512_load_si512( block_sizes.data() ),
+                  _mm512_load_si512( block_flags.data() ) };
+                for ( const auto& s : blake3_schedule ) {
+                    blake3_g_avx512( v, 0, 4, 8, 12, m[ s[ 0 ] ], m[ s[ 1 ] ] );
+                    blake3_g_avx512( v, 1, 5, 9, 13, m[ s[ 2 ] ], m[ s[ 3 ] ] );
+                    blake3_g_avx512( v, 2, 6, 10, 14, m[ s[ 4 ] ], m[ s[ 5 ] ] );
+                    blake3_g_avx512( v, 3, 7, 11, 15, m[ s[ 6 ] ], m[ s[ 7 ] ] );
+                    blake3_g_avx512( v, 0, 5, 10, 15, m[ s[ 8 ] ], m[ s[ 9 ] ] );
+                    blake3_g_avx512( v, 1, 6, 11, 12, m[ s[ 10 ] ], m[ s[ 11 ] ] );
+                    blake3_g_avx512( v, 2, 7, 8, 13, m[ s[ 12 ] ], m[ s[ 13 ] ] );
+                    blake3_g_avx512( v, 3, 4, 9, 14, m[ s[ 14 ] ], m[ s[ 15 ] ] );
+                }
+                const auto active{ _mm512_cmpgt_epu32_mask( counts, _mm512_set1_epi32( static_cast< int >( index ) ) ) };
+                for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                    chaining_value[ i ] = _mm512_mask_xor_epi32( chaining_value[ i ], active, v[ i ], v[ i + 8 ] );
+                }
+            }
+            alignas( 64 ) std::array< std::uint32_t, 8 * lanes > result;
+            for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                _mm512_store_si512( result.data() + i * lanes, chaining_value[ i ] );
+            }
+            scatter_digest_words( result.data(), count, lanes, false, digests );
+        }
+#endif
+        inline auto select_hash_kernel( const hash_algorithm algorithm ) noexcept -> hash_kernel
+        {
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+            const auto& features{ get_cpu_features() };
+            if ( features.avx512f && features.avx512bw ) {
+                return { algorithm == hash_algorithm::sha256 ? sha256_avx512 : blake3_avx512, 16 };
+            }
+            if ( features.avx2 ) {
+                return { algorithm == hash_algorithm::sha256 ? sha256_avx2 : blake3_avx2, 8 };
+            }
+#endif
+            return { algorithm == hash_algorithm::sha256 ? sha256_scalar : blake3_scalar, 1 };
+        }
+    }
+    class message_hasher final
+    {
+      private:
+        hash_algorithm algorithm_;
+        details::hash_kernel kernel_;
+      public:
+        auto algorithm() const noexcept
+        {
+            return algorithm_;
+        }
+        auto lanes() const noexcept
+        {
+            return kernel_.lanes;
+        }
+        auto hash(
+          const std::span< const char* const > messages, const std::span< const std::size_t > sizes,
+          const std::span< hash_digest > digests ) const noexcept
+        {
+            for ( std::size_t i{ 0 }; i < messages.size(); i += kernel_.lanes ) {
+                kernel_.function(
+                  messages.data() + i, sizes.data() + i, std::ranges::min( kernel_.lanes, messages.size() - i ),
+                  digests[ i ].data() );
+            }
+        }
+        auto hash( const std::string_view message ) const noexcept
+        {
+            const auto data{ message.data() };
+            const auto size{ message.size() };
+            hash_digest digest;
+            kernel_.function( &data, &size, 1, digest.data() );
+            return digest;
+        }
+        message_hasher( const hash_algorithm algorithm ) noexcept
+          : algorithm_{ algorithm }
+          , kernel_{ details::select_hash_kernel( algorithm ) }
+        { }
+    };
+    inline auto write_hash_hex( const std::span< char > out, const hash_digest& digest ) noexcept
+    {
+        constexpr std::string_view hex_digits{ "0123456789abcdef" };
+        for ( std::size_t i{ 0 }; i < digest.size(); ++i ) {
+            const auto byte{ std::to_integer< std::uint8_t >( digest[ i ] ) };
+            out[ i * 2 ]     = hex_digits[ byte >> 4 ];
+            out[ i * 2 + 1 ] = hex_digits[ byte & 0xf ];
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#pragma once
+#if defined( _WIN32 ) || defined( _WIN64 )
+# include <io.h>
+# include "windows_definitions.hpp"
+#else
+# include <cerrno>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+namespace cpp_utils
+{
+    inline constexpr std::size_t default_output_buffer_size{ 1uz << 20 };
+    inline constexpr std::size_t default_pipeline_block_size{ 1uz << 18 };
+    class output_buffer final
+    {
+      private:
+        std::FILE* const stream_;
+        const std::size_t capacity_;
+        std::unique_ptr< char[] > data_;
+        std::size_t size_{ 0 };
+        std::size_t flushed_size_{ 0 };
+        bool has_error_{ false };
+      public:
+        auto capacity() const noexcept
+        {
+            return capacity_;
+        }
+        auto flushed_size() const noexcept
+        {
+            return flushed_size_;
+        }
+        auto has_error() const noexcept
+        {
+            return has_error_;
+        }
+        auto commit( const std::size_t size ) noexcept
+        {
+            size_ += size;
+        }
+        auto flush() noexcept
+        {
+            if ( size_ == 0 ) {
+                return;
+            }
+            if ( std::fwrite( data_.get(), 1, size_, stream_ ) != size_ ) {
+                has_error_ = true;
+            }
+            flushed_size_ += size_;
+            size_ = 0;
+        }
+        auto acquire( const std::size_t size ) noexcept
+        {
+            if ( capacity_ - size_ < size ) {
+                flush();
+            }
+            return std::span< char >{ data_.get() + size_, size };
+        }
+        auto write_direct( const std::span< const char > data ) noexcept
+        {
+            flush();
+            if ( std::fwrite( data.data(), 1, data.size(), stream_ ) != data.size() ) {
+                has_error_ = true;
+            }
+            flushed_size_ += data.size();
+        }
+        auto sync() noexcept
+        {
+            flush();
+            if ( std::fflush( stream_ ) != 0 ) {
+                has_error_ = true;
+            }
+        }
+        auto finish() noexcept
+        {
+            sync();
+            if ( std::ferror( stream_ ) != 0 ) {
+                has_error_ = true;
+            }
+            return !has_error_;
+        }
+        auto write( const std::string_view text ) noexcept
+        {
+            if ( text.size() > capacity_ ) {
+                write_direct( text );
+                return;
+            }
+            std::ranges::copy( text, acquire( text.size() ).data() );
+            commit( text.size() );
+        }
+        auto operator=( const output_buffer& ) -> output_buffer& = delete;
+        auto operator=( output_buffer&& ) -> output_buffer&      = delete;
+        output_buffer( std::FILE* const stream, const std::size_t capacity )
+          : stream_{ stream }
+          , capacity_{ capacity }
+          , data_{ std::make_unique_for_overwrite< char[] >( capacity ) }
+        { }
+        output_buffer( const output_buffer& ) = delete;
+        output_buffer( output_buffer&& )      = delete;
+        ~output_buffer() noexcept
+        {
+            flush();
+        }
+    };
+    inline auto read_available( std::FILE* const stream, const std::span< char > data ) noexcept -> std::size_t
+    {
+#if defined( _WIN32 ) || defined( _WIN64 )
+        const auto read_size{
+          _read( _fileno( stream ), data.data(), static_cast< unsigned >( std::ranges::min( data.size(), 1uz << 30 ) ) ) };
+        return read_size > 0 ? static_cast< std::size_t >( read_size ) : 0;
+#else
+        while ( true ) {
+            const auto read_size{ ::read( ::fileno( stream ), data.data(), data.size() ) };
+            if ( read_size >= 0 || errno != EINTR ) {
+                return read_size > 0 ? static_cast< std::size_t >( read_size ) : 0;
+            }
+        }
+#endif
+    }
+    class mapped_file final
+    {
+      private:
+        std::span< const char > data_{};
+#if defined( _WIN32 ) || defined( _WIN64 )
+        HANDLE file_{ INVALID_HANDLE_VALUE };
+        HANDLE mapping_{ nullptr };
+#endif
+      public:
+        auto is_open() const noexcept
+        {
+            return data_.data() != nullptr;
+        }
+        auto data() const noexcept
+        {
+            return data_;
+        }
+        auto operator=( const mapped_file& ) -> mapped_file& = delete;
+        auto operator=( mapped_file&& ) -> mapped_file&      = delete;
+        mapped_file( const std::string_view path ) noexcept
+        {
+            const std::string file_path{ path };
+#if defined( _WIN32 ) || defined( _WIN64 )
+            file_ = CreateFileA(
+              file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+            LARGE_INTEGER size;
+            if ( file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx( file_, &size ) || size.QuadPart == 0 ) {
+                return;
+            }
+            mapping_ = CreateFileMappingA( file_, nullptr, PAGE_READONLY, 0, 0, nullptr );
+            if ( mapping_ == nullptr ) {
+                return;
+            }
+            const auto view{ MapViewOfFile( mapping_, FILE_MAP_READ, 0, 0, 0 ) };
+            if ( view != nullptr ) {
+                data_ = { static_cast< const char* >( view ), static_cast< std::size_t >( size.QuadPart ) };
+            }
+#else
+            const auto file{ ::open( file_path.c_str(), O_RDONLY | O_CLOEXEC ) };
+            if ( file == -1 ) {
+                return;
+            }
+            struct stat status;
+            if ( ::fstat( file, &status ) == 0 && status.st_size > 0 ) {
+                const auto size{ static_cast< std::size_t >( status.st_size ) };
+                const auto view{ ::mmap( nullptr, size, PROT_READ, MAP_SHARED, file, 0 ) };
+                if ( view != MAP_FAILED ) {
+                    ::madvise( view, size, MADV_WILLNEED );
+                    data_ = { static_cast< const char* >( view ), size };
+                }
+            }
+            ::close( file );
+#endif
+        }
+        mapped_file( const mapped_file& ) = delete;
+        mapped_file( mapped_file&& )      = delete;
+        ~mapped_file() noexcept
+        {
+#if defined( _WIN32 ) || defined( _WIN64 )
+            if ( data_.data() != nullptr ) {
+                UnmapViewOfFile( data_.data() );
+            }
+            if ( mapping_ != nullptr ) {
+                CloseHandle( mapping_ );
+            }
+            if ( file_ != INVALID_HANDLE_VALUE ) {
+                CloseHandle( file_ );
+            }
+#else
+            if ( data_.data() != nullptr ) {
+                ::munmap( const_cast< char* >( data_.data() ), data_.size() );
+            }
+#endif
+        }
+    };
+}
\ No newline at end of file
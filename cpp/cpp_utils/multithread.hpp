@@ -1,59 +1,851 @@
 #pragma once
+#if defined( __linux__ )
+# include <pthread.h>
+# include <csignal>
+#endif
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <print>
 #include <ranges>
+#include <span>
 #include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include "compiler.hpp"
 namespace cpp_utils
 {
     using nproc_t = decltype( std::thread::hardware_concurrency() );
-    template < std::random_access_iterator It, std::sentinel_for< It > W, typename F >
-        requires std::invocable< F, decltype( *std::declval< It >() ) >
-    inline auto parallel_for_each( const nproc_t nproc, It&& begin, W&& end, F&& func )
+    namespace details
+    {
+        struct pool_task final
+        {
+            void ( *function )( void*, std::size_t ) noexcept;
+            void* context;
+            std::size_t index;
+            std::atomic< std::size_t >* pending;
+        };
+        class work_stealing_deque final
+        {
+          private:
+            static constexpr std::int64_t capacity_{ 1 << 12 };
+            alignas( 64 ) std::atomic< std::int64_t > top_{ 0 };
+            alignas( 64 ) std::atomic< std::int64_t > bottom_{ 0 };
+            std::unique_ptr< std::atomic< pool_task* >[] > tasks_{
+              std::make_unique< std::atomic< pool_task* >[] >( capacity_ ) };
+            auto& slot_( const std::int64_t position ) const noexcept
+            {
+                return tasks_[ static_cast< std::size_t >( position & ( capacity_ - 1 ) ) ];
+            }
+          public:
+            auto push( pool_task* const task ) noexcept
+            {
+                const auto bottom{ bottom_.load( std::memory_order_relaxed ) };
+                if ( bottom - top_.load( std::memory_order_acquire ) >= capacity_ ) {
+                    return false;
+                }
+                slot_( bottom ).store( task, std::memory_order_relaxed );
+                bottom_.store( bottom + 1, std::memory_order_release );
+                return true;
+            }
+            auto pop() noexcept -> pool_task*
+            {
+                const auto bottom{ bottom_.load( std::memory_order_relaxed ) - 1 };
+                bottom_.store( bottom, std::memory_order_relaxed );
+                std::atomic_thread_fence( std::memory_order_seq_cst );
+                auto top{ top_.load( std::memory_order_relaxed ) };
+                if ( top > bottom ) {
+                    bottom_.store( bottom + 1, std::memory_order_relaxed );
+                    return nullptr;
+                }
+                auto task{ slot_( bottom ).load( std::memory_order_relaxed ) };
+                if ( top == bottom ) {
+                    if ( !top_.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) {
+                        task = nullptr;
+                    }
+                    bottom_.store( bottom + 1, std::memory_order_relaxed );
+                }
+                return task;
+            }
+            auto steal() noexcept -> pool_task*
+            {
+                auto top{ top_.load( std::memory_order_acquire ) };
+                std::atomic_thread_fence( std::memory_order_seq_cst );
+                if ( top >= bottom_.load( std::memory_order_acquire ) ) {
+                    return nullptr;
+                }
+                const auto task{ slot_( top ).load( std::memory_order_relaxed ) };
+                if ( !top_.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) {
+                    return nullptr;
+                }
+                return task;
+            }
+        };
+    }
+    class thread_pool final
     {
-        if ( nproc == 0 ) {
-            if constexpr ( is_debugging_build ) {
-                std::print( "'nproc' cannot be zero!\n" );
-                std::terminate();
+      private:
+        static constexpr auto npos_{ std::numeric_limits< std::size_t >::max() };
+        static constexpr std::size_t spin_rounds_{ 64 };
+        static constexpr std::size_t max_local_tasks_{ 8 };
+        struct worker_identity_ final
+        {
+            const thread_pool* pool;
+            std::size_t index;
+        };
+        static inline thread_local worker_identity_ current_worker_{ nullptr, npos_ };
+        std::size_t num_of_workers_;
+        std::unique_ptr< details::work_stealing_deque[] > deques_;
+        std::vector< std::thread > threads_{};
+        std::mutex injected_mutex_{};
+        std::vector< details::pool_task* > injected_tasks_{};
+        alignas( 64 ) std::atomic< std::size_t > num_of_injected_tasks_{ 0 };
+        alignas( 64 ) std::atomic< std::uint32_t > work_signal_{ 0 };
+        alignas( 64 ) std::atomic< std::uint32_t > completion_signal_{ 0 };
+        std::atomic< bool > is_stopping_{ false };
+        template < typename F >
+        static auto invoke_( void* const context, const std::size_t index ) noexcept
+        {
+            ( *static_cast< F* >( context ) )( index );
+        }
+        auto current_index_() const noexcept
+        {
+            return current_worker_.pool == this ? current_worker_.index : npos_;
+        }
+        auto find_task_( const std::size_t self ) noexcept -> details::pool_task*
+        {
+            if ( self != npos_ ) {
+                if ( const auto task{ deques_[ self ].pop() }; task != nullptr ) {
+                    return task;
+                }
+            }
+            if ( num_of_injected_tasks_.load( std::memory_order_acquire ) != 0 ) {
+                const std::lock_guard lock{ injected_mutex_ };
+                if ( !injected_tasks_.empty() ) {
+                    const auto task{ injected_tasks_.back() };
+                    injected_tasks_.pop_back();
+                    num_of_injected_tasks_.fetch_sub( 1, std::memory_order_relaxed );
+                    return task;
+                }
+            }
+            for ( std::size_t i{ 1 }; i <= num_of_workers_; ++i ) {
+                const auto victim{ ( self == npos_ ? i : self + i ) % num_of_workers_ };
+                if ( victim == self ) {
+                    continue;
+                }
+                if ( const auto task{ deques_[ victim ].steal() }; task != nullptr ) {
+                    return task;
+                }
+            }
+            return nullptr;
+        }
+        auto execute_( details::pool_task& task ) noexcept
+        {
+            const auto pending{ task.pending };
+            task.function( task.context, task.index );
+            if ( pending->fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+                completion_signal_.fetch_add( 1, std::memory_order_release );
+                completion_signal_.notify_all();
+            }
+        }
+        auto work_( const std::size_t index ) noexcept
+        {
+            current_worker_ = { this, index };
+            for ( std::size_t idle_rounds{ 0 };; ) {
+                if ( const auto task{ find_task_( index ) }; task != nullptr ) {
+                    execute_( *task );
+                    idle_rounds = 0;
+                    continue;
+                }
+                if ( ++idle_rounds < spin_rounds_ ) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const auto signal{ work_signal_.load( std::memory_order_seq_cst ) };
+                if ( const auto task{ find_task_( index ) }; task != nullptr ) {
+                    execute_( *task );
+                    idle_rounds = 0;
+                    continue;
+                }
+                if ( is_stopping_.load( std::memory_order_seq_cst ) ) {
+                    return;
+                }
+                work_signal_.wait( signal, std::memory_order_seq_cst );
+            }
+        }
+        auto wait_( const std::atomic< std::size_t >& pending, const std::size_t self ) noexcept
+        {
+            while ( pending.load( std::memory_order_acquire ) != 0 ) {
+                if ( const auto task{ find_task_( self ) }; task != nullptr ) {
+                    execute_( *task );
+                    continue;
+                }
+                const auto signal{ completion_signal_.load( std::memory_order_acquire ) };
+                if ( pending.load( std::memory_order_acquire ) == 0 ) {
+                    break;
+                }
+                completion_signal_.wait( signal, std::memory_order_acquire );
+            }
+        }
+      public:
+        auto size() const noexcept
+        {
+            return num_of_workers_ + 1;
+        }
+        template < typename F >
+            requires std::invocable< F&, std::size_t >
+        auto run( const std::size_t num_of_tasks, F&& func ) noexcept
+        {
+            if ( num_of_tasks <= 1 ) {
+                if ( num_of_tasks == 1 ) {
+                    func( 0 );
+                }
+                return;
+            }
+            std::atomic< std::size_t > pending{ num_of_tasks - 1 };
+            std::array< details::pool_task, max_local_tasks_ > local_tasks;
+            std::vector< details::pool_task > heap_tasks;
+            if ( num_of_tasks - 1 > local_tasks.size() ) {
+                heap_tasks.resize( num_of_tasks - 1 );
+            }
+            const auto tasks{
+              heap_tasks.empty() ? std::span{ local_tasks }.first( num_of_tasks - 1 ) : std::span{ heap_tasks } };
+            for ( std::size_t i{ 0 }; i < tasks.size(); ++i ) {
+                tasks[ i ] = {
+                  &invoke_< std::remove_reference_t< F > >,
+                  const_cast< void* >( static_cast< const void* >( std::addressof( func ) ) ), i + 1, &pending };
+            }
+            const auto self{ current_index_() };
+            if ( self != npos_ ) {
+                for ( auto& task : tasks | std::views::reverse ) {
+                    if ( !deques_[ self ].push( &task ) ) {
+                        execute_( task );
+                    }
+                }
             } else {
-                std::unreachable();
+                const std::lock_guard lock{ injected_mutex_ };
+                for ( auto& task : tasks | std::views::reverse ) {
+                    injected_tasks_.emplace_back( &task );
+                }
+                num_of_injected_tasks_.fetch_add( tasks.size(), std::memory_order_release );
             }
+            work_signal_.fetch_add( 1, std::memory_order_seq_cst );
+            work_signal_.notify_all();
+            func( 0 );
+            wait_( pending, self );
         }
-        if ( begin == end ) {
-            return;
+        auto operator=( const thread_pool& ) -> thread_pool& = delete;
+        auto operator=( thread_pool&& ) -> thread_pool&      = delete;
+        thread_pool( const nproc_t nproc )
+          : num_of_workers_{ std::ranges::max( nproc, 2u ) - 1uz }
+          , deques_{ std::make_unique< details::work_stealing_deque[] >( num_of_workers_ ) }
+        {
+            threads_.reserve( num_of_workers_ );
+            for ( std::size_t i{ 0 }; i < num_of_workers_; ++i ) {
+                threads_.emplace_back( [ this, i ] noexcept
+                {
+#if defined( __linux__ )
+                    sigset_t signals;
+                    ::sigfillset( &signals );
+                    ::pthread_sigmask( SIG_BLOCK, &signals, nullptr );
+#endif
+                    work_( i );
+                } );
+            }
+        }
+        thread_pool( const thread_pool& ) = delete;
+        thread_pool( thread_pool&& )      = delete;
+        ~thread_pool() noexcept
+        {
+            is_stopping_.store( true, std::memory_order_seq_cst );
+            work_signal_.fetch_add( 1, std::memory_order_seq_cst );
+            work_signal_.notify_all();
+            for ( auto& thread : threads_ ) {
+                thread.join();
+            }
+        }
+    };
+    inline auto get_thread_pool() noexcept -> thread_pool&
+    {
+        static thread_pool pool{ std::thread::hardware_concurrency() };
+        return pool;
+    }
+    enum class schedule_policy : std::uint8_t
+    {
+        static_partition,
+        dynamic,
+        guided,
+        auto_partition
+    };
+    struct parallel_options final
+    {
+        schedule_policy schedule{ schedule_policy::static_partition };
+        std::size_t grain_size{ 1 };
+    };
+    namespace details
+    {
+        inline constexpr int auto_partition_extra_depth{ 2 };
+        inline constexpr std::size_t fixed_chunks_per_task{ 4 };
+        inline constexpr std::size_t l1_data_cache_size{ 32 * 1024 };
+        inline constexpr std::size_t l2_cache_size{ 256 * 1024 };
+        inline constexpr std::size_t tile_row_size{ 1024 };
+        inline constexpr std::size_t cache_line_size{ 64 };
+        template < typename T >
+        struct alignas( cache_line_size ) cache_aligned final
+        {
+            T value;
+        };
+        inline auto default_nproc() noexcept
+        {
+            return std::ranges::max( std::thread::hardware_concurrency(), 2u );
+        }
+        inline auto verify_nproc( const nproc_t nproc ) noexcept
+        {
+            if ( nproc == 0 ) {
+                if constexpr ( is_debugging_build ) {
+                    std::print( "'nproc' cannot be zero!\n" );
+                    std::terminate();
+                } else {
+                    std::unreachable();
+                }
+            }
+        }
+        struct auto_partition_context final
+        {
+            thread_pool& pool;
+            std::size_t grain_size;
+            std::size_t max_leaves;
+            std::atomic< std::size_t > num_of_leaves{ 1 };
+        };
+        inline auto try_add_leaf( auto_partition_context& context ) noexcept
+        {
+            auto num_of_leaves{ context.num_of_leaves.load( std::memory_order_relaxed ) };
+            while ( num_of_leaves < context.max_leaves
+                    && !context.num_of_leaves.compare_exchange_weak(
+                      num_of_leaves, num_of_leaves + 1, std::memory_order_relaxed ) )
+            { }
+            return num_of_leaves < context.max_leaves;
         }
-        const auto total{ std::ranges::distance( begin, end ) };
-        const auto nproc_for_executing{ std::ranges::min( static_cast< std::ptrdiff_t >( nproc ), total ) };
-        const auto chunk_size{ total / nproc_for_executing };
-        const auto remainder{ total % nproc_for_executing };
-        std::vector< std::thread > threads;
-        threads.reserve( nproc_for_executing );
-        for ( std::ptrdiff_t i{ 0 }; i < nproc_for_executing; ++i ) {
-            auto chunk_start{ begin + i * chunk_size + std::ranges::min( i, remainder ) };
-            auto chunk_end{ chunk_start + chunk_size + ( i < remainder ? 1 : 0 ) };
-            threads.emplace_back( [ =, &func ] mutable
+        template < typename F >
+        inline auto auto_partition(
+          auto_partition_context& context, const std::size_t first, const std::size_t last, int depth,
+          const std::thread::id parent, F& body ) noexcept -> void
+        {
+            const auto current{ std::this_thread::get_id() };
+            if ( current != parent ) {
+                ++depth;
+            }
+            if ( depth <= 0 || last - first < context.grain_size * 2 || !try_add_leaf( context ) ) {
+                body( first, last );
+                context.num_of_leaves.fetch_sub( 1, std::memory_order_relaxed );
+                return;
+            }
+            const auto middle{ first + ( last - first ) / 2 };
+            context.pool.run( 2, [ & ]( const std::size_t half ) noexcept
             {
-                for ( auto& it{ chunk_start }; it != chunk_end; ++it ) {
-                    func( *it );
+                if ( half == 0 ) {
+                    auto_partition( context, first, middle, depth - 1, current, body );
+                } else {
+                    auto_partition( context, middle, last, depth - 1, current, body );
                 }
             } );
         }
-        for ( auto& thread : threads ) {
-            thread.join();
+        template < typename F >
+            requires std::invocable< F&, std::size_t, std::size_t >
+        inline auto parallel_for_ranges(
+          const nproc_t nproc, const std::size_t total, const parallel_options& options, F&& body ) noexcept
+        {
+            if ( total == 0 ) {
+                return;
+            }
+            auto& pool{ get_thread_pool() };
+            const auto grain_size{ std::ranges::max( options.grain_size, 1uz ) };
+            const auto num_of_tasks{
+              std::ranges::max( std::ranges::min( static_cast< std::size_t >( nproc ), total / grain_size ), 1uz ) };
+            switch ( options.schedule ) {
+                case schedule_policy::dynamic : {
+                    std::atomic< std::size_t > cursor{ 0 };
+                    pool.run( num_of_tasks, [ & ]( std::size_t ) noexcept
+                    {
+                        for ( auto first{ cursor.fetch_add( grain_size, std::memory_order_relaxed ) }; first < total;
+                              first = cursor.fetch_add( grain_size, std::memory_order_relaxed ) )
+                        {
+                            body( first, std::ranges::min( first + grain_size, total ) );
+                        }
+                    } );
+                    return;
+                }
+                case schedule_policy::guided : {
+                    std::atomic< std::size_t > cursor{ 0 };
+                    pool.run( num_of_tasks, [ & ]( std::size_t ) noexcept
+                    {
+                        for ( auto first{ cursor.load( std::memory_order_relaxed ) }; first < total; ) {
+                            const auto size{ std::ranges::min(
+                              std::ranges::max( ( total - first ) / ( num_of_tasks * 2 ), grain_size ), total - first ) };
+                            if ( cursor.compare_exchange_weak( first, first + size, std::memory_order_relaxed ) ) {
+                                body( first, first + size );
+                                first = cursor.load( std::memory_order_relaxed );
+                            }
+                        }
+                    } );
+                    return;
+                }
+                case schedule_policy::auto_partition : {
+                    if ( num_of_tasks == 1 ) {
+                        body( 0, total );
+                        return;
+                    }
+                    auto_partition_context context{ pool, grain_size, num_of_tasks };
+                    auto_partition(
+                      context, 0, total, std::bit_width( num_of_tasks - 1 ) + auto_partition_extra_depth,
+                      std::this_thread::get_id(), body );
+                    return;
+                }
+                default : {
+                    const auto chunk_size{ total / num_of_tasks };
+                    const auto remainder{ total % num_of_tasks };
+                    pool.run( num_of_tasks, [ & ]( const std::size_t i ) noexcept
+                    {
+                        const auto first{ i * chunk_size + std::ranges::min( i, remainder ) };
+                        body( first, first + chunk_size + ( i < remainder ? 1 : 0 ) );
+                    } );
+                }
+            }
+        }
+        inline auto num_of_fixed_chunks( const nproc_t nproc, const std::size_t total, const parallel_options& options ) noexcept
+        {
+            const auto grain_size{ std::ranges::max( options.grain_size, 1uz ) };
+            return std::ranges::max(
+              std::ranges::min( static_cast< std::size_t >( nproc ) * fixed_chunks_per_task, total / grain_size ), 1uz );
+        }
+        template < typename F >
+            requires std::invocable< F&, std::size_t, std::size_t, std::size_t >
+        inline auto parallel_for_fixed_chunks(
+          const nproc_t nproc, const std::size_t total, const std::size_t num_of_chunks, const schedule_policy schedule,
+          F&& body ) noexcept
+        {
+            const auto chunk_size{ total / num_of_chunks };
+            const auto remainder{ total % num_of_chunks };
+            parallel_for_ranges(
+              nproc, num_of_chunks, { schedule, 1 },
+              [ & ]( const std::size_t first_chunk, const std::size_t last_chunk ) noexcept
+            {
+                for ( auto chunk{ first_chunk }; chunk < last_chunk; ++chunk ) {
+                    const auto first{ chunk * chunk_size + std::ranges::min( chunk, remainder ) };
+                    body( chunk, first, first + chunk_size + ( chunk < remainder ? 1 : 0 ) );
+                }
+            } );
+        }
+        template < std::size_t N, typename F >
+            requires std::invocable< F&, const std::array< std::size_t, N >&, const std::array< std::size_t, N >& >
+        inline auto parallel_for_tiles(
+          const nproc_t nproc, const std::array< std::size_t, N >& extents, const std::array< std::size_t, N >& tile,
+          const parallel_options& options, F&& body ) noexcept
+        {
+            std::array< std::size_t, N > num_of_tiles;
+            std::size_t total{ 1 };
+            for ( std::size_t d{ 0 }; d < N; ++d ) {
+                const auto tile_extent{ std::ranges::max( tile[ d ], 1uz ) };
+                num_of_tiles[ d ] = extents[ d ] / tile_extent + ( extents[ d ] % tile_extent != 0 ? 1 : 0 );
+                total *= num_of_tiles[ d ];
+            }
+            parallel_for_ranges( nproc, total, options, [ & ]( const std::size_t first, const std::size_t last ) noexcept
+            {
+                std::array< std::size_t, N > lower;
+                std::array< std::size_t, N > upper;
+                for ( auto index{ first }; index < last; ++index ) {
+                    for ( auto d{ N }, rest{ index }; d-- > 0; rest /= num_of_tiles[ d ] ) {
+                        const auto tile_extent{ std::ranges::max( tile[ d ], 1uz ) };
+                        lower[ d ] = rest % num_of_tiles[ d ] * tile_extent;
+                        upper[ d ] = std::ranges::min( lower[ d ] + tile_extent, extents[ d ] );
+                    }
+                    body( lower, upper );
+                }
+            } );
         }
+        template < typename It >
+        using parallel_chunk = std::conditional_t<
+          std::contiguous_iterator< std::remove_cvref_t< It > >,
+          std::span< std::remove_reference_t< std::iter_reference_t< std::remove_cvref_t< It > > > >,
+          std::ranges::subrange< std::remove_cvref_t< It > > >;
+        template < typename It >
+        inline auto make_parallel_chunk( const It& begin, const std::size_t first, const std::size_t last ) noexcept
+          -> parallel_chunk< It >
+        {
+            if constexpr ( std::contiguous_iterator< It > ) {
+                return { std::to_address( begin ) + first, last - first };
+            } else {
+                return { begin + static_cast< std::ptrdiff_t >( first ), begin + static_cast< std::ptrdiff_t >( last ) };
+            }
+        }
+    }
+    template < std::random_access_iterator It, std::sentinel_for< It > W, typename F >
+        requires std::invocable< F, decltype( *std::declval< It >() ) >
+    inline auto parallel_for_each( const nproc_t nproc, It begin, W end, F&& func, const parallel_options& options = {} )
+    {
+        details::verify_nproc( nproc );
+        if ( begin == end ) {
+            return;
+        }
+        details::parallel_for_ranges(
+          nproc, static_cast< std::size_t >( std::ranges::distance( begin, end ) ), options,
+          [ & ]( const std::size_t first, const std::size_t last ) noexcept
+        {
+            const auto chunk_end{ begin + static_cast< std::ptrdiff_t >( last ) };
+            for ( auto it{ begin + static_cast< std::ptrdiff_t >( first ) }; it != chunk_end; ++it ) {
+                func( *it );
+            }
+        } );
     }
     template < std::random_access_iterator It, std::sentinel_for< It > W, typename F >
         requires std::invocable< F, decltype( *std::declval< It >() ) >
-    inline auto parallel_for_each( It&& begin, W&& end, F&& func )
+    inline auto parallel_for_each( It begin, W end, F&& func, const parallel_options& options = {} )
+    {
+        parallel_for_each( details::default_nproc(), begin, end, std::forward< F >( func ), options );
+    }
+    template < std::ranges::random_access_range R, typename F >
+        requires std::ranges::sized_range< R > && std::invocable< F, std::ranges::range_reference_t< R > >
+    inline auto parallel_for_each( const nproc_t nproc, R&& range, F&& func, const parallel_options& options = {} )
+    {
+        parallel_for_each( nproc, std::ranges::begin( range ), std::ranges::end( range ), std::forward< F >( func ), options );
+    }
+    template < std::ranges::random_access_range R, typename F >
+        requires std::ranges::sized_range< R > && std::invocable< F, std::ranges::range_reference_t< R > >
+    inline auto parallel_for_each( R&& range, F&& func, const parallel_options& options = {} )
     {
         parallel_for_each(
-          std::ranges::max( std::thread::hardware_concurrency(), 2u ), std::forward< It >( begin ), std::forward< It >( end ),
-          std::forward< F >( func ) );
+          details::default_nproc(), std::ranges::begin( range ), std::ranges::end( range ), std::forward< F >( func ),
+          options );
+    }
+    template < std::random_access_iterator It, std::sentinel_for< It > W, typename F >
+        requires std::invocable< F, details::parallel_chunk< It > >
+    inline auto parallel_for_chunks( const nproc_t nproc, It begin, W end, F&& func, const parallel_options& options = {} )
+    {
+        details::verify_nproc( nproc );
+        if ( begin == end ) {
+            return;
+        }
+        const auto total{ static_cast< std::size_t >( std::ranges::distance( begin, end ) ) };
+        std::size_t line_size{ 1 };
+        std::size_t padding{ 0 };
+        if constexpr ( std::contiguous_iterator< std::remove_cvref_t< It > > ) {
+            constexpr auto element_size{ sizeof( std::iter_value_t< It > ) };
+            const auto address{ reinterpret_cast< std::uintptr_t >( std::to_address( begin ) ) };
+            if ( details::cache_line_size % element_size == 0 && address % element_size == 0 ) {
+                line_size = details::cache_line_size / element_size;
+                padding   = address % details::cache_line_size / element_size;
+            }
+        }
+        const auto padded_size{ total + padding };
+        const auto min_chunk_size{ std::ranges::max( options.grain_size, 1uz ) + padding };
+        const auto unit_size{ ( min_chunk_size / line_size + ( min_chunk_size % line_size != 0 ? 1 : 0 ) ) * line_size };
+        const auto num_of_units{ std::ranges::max( padded_size / unit_size, 1uz ) };
+        details::parallel_for_ranges(
+          nproc, num_of_units, { options.schedule, 1 },
+          [ & ]( const std::size_t first_unit, const std::size_t last_unit ) noexcept
+        {
+            const auto first{ std::ranges::max( first_unit * unit_size, padding ) - padding };
+            const auto last{ ( last_unit == num_of_units ? padded_size : last_unit * unit_size ) - padding };
+            func( details::make_parallel_chunk( begin, first, last ) );
+        } );
+    }
+    template < std::random_access_iterator It, std::sentinel_for< It > W, typename F >
+        requires std::invocable< F, details::parallel_chunk< It > >
+    inline auto parallel_for_chunks( It begin, W end, F&& func, const parallel_options& options = {} )
+    {
+        parallel_for_chunks( details::default_nproc(), begin, end, std::forward< F >( func ), options );
+    }
+    template < std::ranges::random_access_range R, typename F >
+        requires std::ranges::sized_range< R > && std::invocable< F, details::parallel_chunk< std::ranges::iterator_t< R > > >
+    inline auto parallel_for_chunks( const nproc_t nproc, R&& range, F&& func, const parallel_options& options = {} )
+    {
+        parallel_for_chunks( nproc, std::ranges::begin( range ), std::ranges::end( range ), std::forward< F >( func ), options );
+    }
+    template < std::ranges::random_access_range R, typename F >
+        requires std::ranges::sized_range< R > && std::invocable< F, details::parallel_chunk< std::ranges::iterator_t< R > > >
+    inline auto parallel_for_chunks( R&& range, F&& func, const parallel_options& options = {} )
+    {
+        parallel_for_chunks(
+          details::default_nproc(), std::ranges::begin( range ), std::ranges::end( range ), std::forward< F >( func ),
+          options );
+    }
+    template < typename F >
+        requires std::invocable< F, std::size_t >
+    inline auto parallel_for( const nproc_t nproc, const std::size_t n, F&& func, const parallel_options& options = {} )
+    {
+        details::verify_nproc( nproc );
+        details::parallel_for_ranges(
+          nproc, n, options, [ & ]( const std::size_t first, const std::size_t last ) noexcept
+        {
+            for ( auto i{ first }; i < last; ++i ) {
+                func( i );
+            }
+        } );
+    }
+    template < typename F >
+        requires std::invocable< F, std::size_t >
+    inline auto parallel_for( const std::size_t n, F&& func, const parallel_options& options = {} )
+    {
+        parallel_for( details::default_nproc(), n, std::forward< F >( func ), options );
+    }
+    inline constexpr auto make_tile_extents_2d( const std::size_t element_size ) noexcept
+    {
+        const auto columns{ std::bit_floor( std::ranges::max( details::tile_row_size / element_size, 1uz ) ) };
+        return std::array{ std::ranges::max( details::l1_data_cache_size / 2 / ( columns * element_size ), 1uz ), columns };
+    }
+    inline constexpr auto make_tile_extents_3d( const std::size_t element_size ) noexcept
+    {
+        const auto [ rows, columns ]{ make_tile_extents_2d( element_size ) };
+        return std::array{
+          std::ranges::max( details::l2_cache_size / 2 / ( rows * columns * element_size ), 1uz ), rows, columns };
+    }
+    template < typename F >
+        requires std::invocable< F, std::size_t, std::size_t >
+    inline auto parallel_for_2d(
+      const nproc_t nproc, const std::size_t rows, const std::size_t columns, F&& func, const parallel_options& options = {},
+      const std::array< std::size_t, 2 >& tile = make_tile_extents_2d( sizeof( double ) ) )
+    {
+        details::verify_nproc( nproc );
+        details::parallel_for_tiles(
+          nproc, std::array{ rows, columns }, tile, options,
+          [ & ]( const std::array< std::size_t, 2 >& lower, const std::array< std::size_t, 2 >& upper ) noexcept
+        {
+            for ( auto i{ lower[ 0 ] }; i < upper[ 0 ]; ++i ) {
+                for ( auto j{ lower[ 1 ] }; j < upper[ 1 ]; ++j ) {
+                    func( i, j );
+                }
+            }
+        } );
+    }
+    template < typename F >
+        requires std::invocable< F, std::size_t, std::size_t >
+    inline auto parallel_for_2d(
+      const std::size_t rows, const std::size_t columns, F&& func, const parallel_options& options = {},
+      const std::array< std::size_t, 2 >& tile = make_tile_extents_2d( sizeof( double ) ) )
+    {
+        parallel_for_2d( details::default_nproc(), rows, columns, std::forward< F >( func ), options, tile );
+    }
+    template < typename F >
+        requires std::invocable< F, std::size_t, std::size_t, std::size_t >
+    inline auto parallel_for_3d(
+      const nproc_t nproc, const std::size_t layers, const std::size_t rows, const std::size_t columns, F&& func,
+      const parallel_options& options = {}, const std::array< std::size_t, 3 >& tile = make_tile_extents_3d( sizeof( double ) ) )
+    {
+        details::verify_nproc( nproc );
+        details::parallel_for_tiles(
+          nproc, std::array{ layers, rows, columns }, tile, options,
+          [ & ]( const std::array< std::size_t, 3 >& lower, const std::array< std::size_t, 3 >& upper ) noexcept
+        {
+            for ( auto i{ lower[ 0 ] }; i < upper[ 0 ]; ++i ) {
+                for ( auto j{ lower[ 1 ] }; j < upper[ 1 ]; ++j ) {
+                    for ( auto k{ lower[ 2 ] }; k < upper[ 2 ]; ++k ) {
+                        func( i, j, k );
+                    }
+                }
+            }
+        } );
+    }
+    template < typename F >
+        requires std::invocable< F, std::size_t, std::size_t, std::size_t >
+    inline auto parallel_for_3d(
+      const std::size_t layers, const std::size_t rows, const std::size_t columns, F&& func,
+      const parallel_options& options = {}, const std::array< std::size_t, 3 >& tile = make_tile_extents_3d( sizeof( double ) ) )
+    {
+        parallel_for_3d( details::default_nproc(), layers, rows, columns, std::forward< F >( func ), options, tile );
+    }
+    template < std::random_access_iterator It, std::sentinel_for< It > W, typename T, typename Op, typename Transform >
+        requires std::invocable< Transform&, decltype( *std::declval< It >() ) >
+    inline auto parallel_transform_reduce(
+      const nproc_t nproc, It begin, W end, T init, Op&& op, Transform&& transform, const parallel_options& options = {} ) -> T
+    {
+        details::verify_nproc( nproc );
+        if ( begin == end ) {
+            return init;
+        }
+        const auto total{ static_cast< std::size_t >( std::ranges::distance( begin, end ) ) };
+        const auto num_of_chunks{ details::num_of_fixed_chunks( nproc, total, options ) };
+        std::vector< details::cache_aligned< std::optional< T > > > partials( num_of_chunks );
+        details::parallel_for_fixed_chunks(
+          nproc, total, num_of_chunks, options.schedule,
+          [ & ]( const std::size_t chunk, const std::size_t first, const std::size_t last ) noexcept
+        {
+            const auto chunk_end{ begin + static_cast< std::ptrdiff_t >( last ) };
+            auto it{ begin + static_cast< std::ptrdiff_t >( first ) };
+            auto partial{ static_cast< T >( transform( *it ) ) };
+            for ( ++it; it != chunk_end; ++it ) {
+                partial = op( std::move( partial ), transform( *it ) );
+            }
+            partials[ chunk ].value.emplace( std::move( partial ) );
+        } );
+        for ( auto& partial : partials ) {
+            init = op( std::move( init ), std::move( *partial.value ) );
+        }
+        return init;
+    }
+    template < std::random_access_iterator It, std::sentinel_for< It > W, typename T, typename Op, typename Transform >
+        requires std::invocable< Transform&, decltype( *std::declval< It >() ) >
+    inline auto parallel_transform_reduce(
+      It begin, W end, T init, Op&& op, Transform&& transform, const parallel_options& options = {} ) -> T
+    {
+        return parallel_transform_reduce(
+          details::default_nproc(), begin, end, std::move( init ), std::forward< Op >( op ),
+          std::forward< Transform >( transform ), options );
+    }
+    template < std::random_access_iterator It, std::sentinel_for< It > W, typename T, typename Op = std::plus<> >
+        requires std::invocable< Op&, T, decltype( *std::declval< It >() ) >
+    inline auto parallel_reduce(
+      const nproc_t nproc, It begin, W end, T init, Op&& op = {}, const parallel_options& options = {} ) -> T
+    {
+        return parallel_transform_reduce(
+          nproc, begin, end, std::move( init ), std::forward< Op >( op ), std::identity{}, options );
+    }
+    template < std::random_access_iterator It, std::sentinel_for< It > W, typename T, typename Op = std::plus<> >
+        requires std::invocable< Op&, T, decltype( *std::declval< It >() ) >
+    inline auto parallel_reduce( It begin, W end, T init, Op&& op = {}, const parallel_options& options = {} ) -> T
+    {
+        return parallel_transform_reduce(
+          details::default_nproc(), begin, end, std::move( init ), std::forward< Op >( op ), std::identity{}, options );
+    }
+    template <
+      std::random_access_iterator It, std::sentinel_for< It > W, std::random_access_iterator O, typename Op = std::plus<> >
+        requires std::invocable< Op&, std::iter_value_t< It >, decltype( *std::declval< It >() ) >
+    inline auto parallel_inclusive_scan(
+      const nproc_t nproc, It begin, W end, O out, Op&& op = {}, const parallel_options& options = {} )
+    {
+        using value_type = std::iter_value_t< It >;
+        details::verify_nproc( nproc );
+        auto result{ out };
+        if ( begin == end ) {
+            return result;
+        }
+        const auto total{ static_cast< std::size_t >( std::ranges::distance( begin, end ) ) };
+        const auto num_of_chunks{ details::num_of_fixed_chunks( nproc, total, options ) };
+        std::vector< details::cache_aligned< std::optional< value_type > > > offsets( num_of_chunks );
+        details::parallel_for_fixed_chunks(
+          nproc, total, num_of_chunks, options.schedule,
+          [ & ]( const std::size_t chunk, const std::size_t first, const std::size_t last ) noexcept
+        {
+            if ( chunk + 1 == num_of_chunks ) {
+                return;
+            }
+            const auto chunk_end{ begin + static_cast< std::ptrdiff_t >( last ) };
+            auto it{ begin + static_cast< std::ptrdiff_t >( first ) };
+            value_type partial( *it );
+            for ( ++it; it != chunk_end; ++it ) {
+                partial = op( std::move( partial ), *it );
+            }
+            offsets[ chunk + 1 ].value.emplace( std::move( partial ) );
+        } );
+        for ( std::size_t i{ 2 }; i < num_of_chunks; ++i ) {
+            offsets[ i ].value = op( *offsets[ i - 1 ].value, std::move( *offsets[ i ].value ) );
+        }
+        details::parallel_for_fixed_chunks(
+          nproc, total, num_of_chunks, options.schedule,
+          [ & ]( const std::size_t chunk, const std::size_t first, const std::size_t last ) noexcept
+        {
+            const auto chunk_end{ begin + static_cast< std::ptrdiff_t >( last ) };
+            auto it{ begin + static_cast< std::ptrdiff_t >( first ) };
+            auto destination{ out + static_cast< std::ptrdiff_t >( first ) };
+            value_type sum( chunk == 0 ? value_type( *it ) : op( *offsets[ chunk ].value, *it ) );
+            *destination = sum;
+            for ( ++it, ++destination; it != chunk_end; ++it, ++destination ) {
+                sum          = op( std::move( sum ), *it );
+                *destination = sum;
+            }
+        } );
+        return result + static_cast< std::ptrdiff_t >( total );
+    }
+    template <
+      std::random_access_iterator It, std::sentinel_for< It > W, std::random_access_iterator O, typename Op = std::plus<> >
+        requires std::invocable< Op&, std::iter_value_t< It >, decltype( *std::declval< It >() ) >
+    inline auto parallel_inclusive_scan( It begin, W end, O out, Op&& op = {}, const parallel_options& options = {} )
+    {
+        return parallel_inclusive_scan( details::default_nproc(), begin, end, out, std::forward< Op >( op ), options );
     }
+    class ordered_block_ring final
+    {
+      private:
+        struct alignas( 64 ) slot_ final
+        {
+            std::atomic< std::size_t > sequence{ 0 };
+            std::size_t size{ 0 };
+        };
+        std::size_t depth_;
+        std::size_t block_size_;
+        std::unique_ptr< slot_[] > slots_;
+        std::unique_ptr< char[] > blocks_;
+        static auto wait_for_( slot_& slot, const std::size_t sequence ) noexcept
+        {
+            for ( auto current{ slot.sequence.load( std::memory_order_acquire ) }; current != sequence;
+                  current = slot.sequence.load( std::memory_order_acquire ) )
+            {
+                slot.sequence.wait( current, std::memory_order_acquire );
+            }
+        }
+        auto block_( const std::size_t sequence ) const noexcept
+        {
+            return blocks_.get() + sequence % depth_ * block_size_;
+        }
+      public:
+        auto depth() const noexcept
+        {
+            return depth_;
+        }
+        auto block_size() const noexcept
+        {
+            return block_size_;
+        }
+        auto acquire( const std::size_t sequence ) noexcept
+        {
+            wait_for_( slots_[ sequence % depth_ ], sequence );
+            return std::span< char >{ block_( sequence ), block_size_ };
+        }
+        auto publish( const std::size_t sequence, const std::size_t size ) noexcept
+        {
+            auto& slot{ slots_[ sequence % depth_ ] };
+            slot.size = size;
+            slot.sequence.store( sequence + 1, std::memory_order_release );
+            slot.sequence.notify_all();
+        }
+        auto consume( const std::size_t sequence ) noexcept
+        {
+            auto& slot{ slots_[ sequence % depth_ ] };
+            wait_for_( slot, sequence + 1 );
+            return std::span< const char >{ block_( sequence ), slot.size };
+        }
+        auto release( const std::size_t sequence ) noexcept
+        {
+            auto& slot{ slots_[ sequence % depth_ ] };
+            slot.sequence.store( sequence + depth_, std::memory_order_release );
+            slot.sequence.notify_all();
+        }
+        auto operator=( const ordered_block_ring& ) -> ordered_block_ring& = delete;
+        auto operator=( ordered_block_ring&& ) -> ordered_block_ring&      = delete;
+        ordered_block_ring( const std::size_t depth, const std::size_t block_size )
+          : depth_{ std::ranges::max( depth, 2uz ) }
+          , block_size_{ block_size }
+          , slots_{ std::make_unique< slot_[] >( depth_ ) }
+          , blocks_{ std::make_unique_for_overwrite< char[] >( depth_ * block_size_ ) }
+        {
+            for ( std::size_t i{ 0 }; i < depth_; ++i ) {
+                slots_[ i ].sequence.store( i, std::memory_order_relaxed );
+            }
+        }
+        ordered_block_ring( const ordered_block_ring& ) = delete;
+        ordered_block_ring( ordered_block_ring&& )      = delete;
+        ~ordered_block_ring()                           = default;
+    };
     class [[deprecated( "use STL container instead" )]] thread_manager final
     {
       private:
@@ -0,0 +1,1307 @@
+#pragma once
+#if __has_include( <generator> )
+# include <generator>
+#endif
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <print>
+#include <random>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "binary_fuse_filter.hpp"
+#include "compiler.hpp"
+#include "const_string.hpp"
+#include "hash.hpp"
+#include "io.hpp"
+#include "multithread.hpp"
+#include "password_strength.hpp"
+#include "random.hpp"
+namespace cpp_utils
+{
+    namespace character_class
+    {
+        inline constexpr unsigned capital_letters{ 1u << 0 };
+        inline constexpr unsigned lowercase_letters{ 1u << 1 };
+        inline constexpr unsigned numbers{ 1u << 2 };
+        inline constexpr unsigned special_characters{ 1u << 3 };
+        inline constexpr unsigned all{ capital_letters | lowercase_letters | numbers | special_characters };
+    }
+    namespace character_set
+    {
+        inline constexpr basic_const_string capital_letters{ "ABCDEFGHIJKLMNOPQRSTUVWXYZ" };
+        inline constexpr basic_const_string lowercase_letters{ "abcdefghijklmnopqrstuvwxyz" };
+        inline constexpr basic_const_string numbers{ "123456789" };
+        inline constexpr basic_const_string special_characters{ R"(!"#$%&'()*+,-./:;<=>?@[\]^_`{|})" };
+        inline constexpr basic_const_string capital_vowels{ "AEIOU" };
+        inline constexpr basic_const_string capital_consonants{ "BCDFGHJKLMNPQRSTVWXYZ" };
+        inline constexpr basic_const_string lowercase_vowels{ "aeiou" };
+        inline constexpr basic_const_string lowercase_consonants{ "bcdfghjklmnpqrstvwxyz" };
+    }
+    template < unsigned Classes >
+        requires( Classes != 0 && ( Classes & ~character_class::all ) == 0 )
+    inline constexpr auto password_dictionary{ [] consteval
+    {
+        constexpr auto size{
+          ( Classes & character_class::capital_letters ? character_set::capital_letters.size() : 0 )
+          + ( Classes & character_class::lowercase_letters ? character_set::lowercase_letters.size() : 0 )
+          + ( Classes & character_class::numbers ? character_set::numbers.size() : 0 )
+          + ( Classes & character_class::special_characters ? character_set::special_characters.size() : 0 ) };
+        std::array< char, size > result{};
+        auto it{ result.begin() };
+        if constexpr ( Classes & character_class::capital_letters ) {
+            it = std::ranges::copy( character_set::capital_letters, it ).out;
+        }
+        if constexpr ( Classes & character_class::lowercase_letters ) {
+            it = std::ranges::copy( character_set::lowercase_letters, it ).out;
+        }
+        if constexpr ( Classes & character_class::numbers ) {
+            it = std::ranges::copy( character_set::numbers, it ).out;
+        }
+        if constexpr ( Classes & character_class::special_characters ) {
+            std::ranges::copy( character_set::special_characters, it );
+        }
+        return basic_const_string{ result };
+    }() };
+    namespace details
+    {
+        template < unsigned... Classes >
+        inline auto make_password_sampler( const unsigned classes, std::integer_sequence< unsigned, Classes... > )
+        {
+            std::optional< symbol_sampler > sampler;
+            ( ( classes == Classes + 1 ? ( sampler.emplace( password_dictionary< Classes + 1 > ), void() ) : void() ), ... );
+            return sampler;
+        }
+    }
+    inline auto make_password_sampler( const unsigned classes )
+    {
+        return details::make_password_sampler( classes, std::make_integer_sequence< unsigned, character_class::all >{} );
+    }
+    class password_policy final
+    {
+      private:
+        static constexpr std::size_t num_of_classes_{ 4 };
+        static constexpr std::size_t max_table_size_{ 1uz << 20 };
+        static constexpr std::uint64_t threshold_limit_{ 1ull << 63 };
+        std::array< std::string_view, num_of_classes_ > symbols_{};
+        std::size_t length_{ 0 };
+        std::size_t num_of_states_{ 1 };
+        std::size_t initial_state_{ 0 };
+        double log_compliant_fraction_{ 0 };
+        std::vector< std::array< std::size_t, num_of_classes_ > > transitions_{};
+        std::vector< std::array< std::uint64_t, num_of_classes_ > > thresholds_{};
+        auto build_tables_() noexcept
+        {
+            constexpr auto infeasible{ -std::numeric_limits< double >::infinity() };
+            std::array< double, num_of_classes_ > log_weights;
+            double total_size{ 0 };
+            for ( const auto symbols : symbols_ ) {
+                total_size += static_cast< double >( symbols.size() );
+            }
+            for ( std::size_t i{ 0 }; i < num_of_classes_; ++i ) {
+                log_weights[ i ]
+                  = symbols_[ i ].empty() ? infeasible : std::log( static_cast< double >( symbols_[ i ].size() ) / total_size );
+            }
+            std::vector< double > previous( num_of_states_, infeasible );
+            std::vector< double > current( num_of_states_ );
+            previous[ 0 ] = 0;
+            thresholds_.resize( length_ * num_of_states_ );
+            for ( std::size_t remaining{ 1 }; remaining <= length_; ++remaining ) {
+                for ( std::size_t state{ 0 }; state < num_of_states_; ++state ) {
+                    std::array< double, num_of_classes_ > log_masses;
+                    auto max_log_mass{ infeasible };
+                    for ( std::size_t i{ 0 }; i < num_of_classes_; ++i ) {
+                        log_masses[ i ] = log_weights[ i ] + previous[ transitions_[ state ][ i ] ];
+                        max_log_mass    = std::ranges::max( max_log_mass, log_masses[ i ] );
+                    }
+                    auto& thresholds{ thresholds_[ ( remaining - 1 ) * num_of_states_ + state ] };
+                    if ( max_log_mass == infeasible ) {
+                        current[ state ] = infeasible;
+                        thresholds.fill( threshold_limit_ );
+                        continue;
+                    }
+                    double sum{ 0 };
+                    for ( const auto log_mass : log_masses ) {
+                        sum += std::exp( log_mass - max_log_mass );
+                    }
+                    current[ state ] = max_log_mass + std::log( sum );
+                    std::size_t last_class{ 0 };
+                    for ( std::size_t i{ 0 }; i < num_of_classes_; ++i ) {
+                        if ( log_masses[ i ] != infeasible ) {
+                            last_class = i;
+                        }
+                    }
+                    double cumulative{ 0 };
+                    std::uint64_t threshold{ 0 };
+                    for ( std::size_t i{ 0 }; i < num_of_classes_; ++i ) {
+                        if ( i >= last_class ) {
+                            threshold = threshold_limit_;
+                        } else if ( log_masses[ i ] != infeasible ) {
+                            cumulative += std::exp( log_masses[ i ] - current[ state ] );
+                            threshold = std::ranges::min(
+                              static_cast< std::uint64_t >( cumulative * static_cast< double >( threshold_limit_ ) ),
+                              threshold_limit_ );
+                        }
+                        thresholds[ i ] = threshold;
+                    }
+                }
+                std::swap( previous, current );
+            }
+            log_compliant_fraction_ = previous[ initial_state_ ];
+            return log_compliant_fraction_ != infeasible;
+        }
+        password_policy(
+          const unsigned classes, const std::array< std::size_t, num_of_classes_ >& minimums, const std::size_t length ) noexcept
+          : length_{ length }
+        {
+            constexpr std::array< std::string_view, num_of_classes_ > class_symbols{
+              character_set::capital_letters, character_set::lowercase_letters, character_set::numbers,
+              character_set::special_characters };
+            std::array< std::size_t, num_of_classes_ > strides;
+            for ( std::size_t i{ 0 }; i < num_of_classes_; ++i ) {
+                if ( classes & ( 1u << i ) ) {
+                    symbols_[ i ] = class_symbols[ i ];
+                }
+                strides[ i ] = num_of_states_;
+                initial_state_ += minimums[ i ] * num_of_states_;
+                num_of_states_ *= minimums[ i ] + 1;
+            }
+            transitions_.resize( num_of_states_ );
+            for ( std::size_t state{ 0 }; state < num_of_states_; ++state ) {
+                for ( std::size_t i{ 0 }; i < num_of_classes_; ++i ) {
+                    const auto deficit{ state / strides[ i ] % ( minimums[ i ] + 1 ) };
+                    transitions_[ state ][ i ] = deficit == 0 ? state : state - strides[ i ];
+                }
+            }
+        }
+      public:
+        auto length() const noexcept
+        {
+            return length_;
+        }
+        auto log_compliant_fraction() const noexcept
+        {
+            return log_compliant_fraction_;
+        }
+        template < typename Engine >
+        auto generate( std::span< char > password, symbol_stream< Engine >& symbols ) const noexcept
+        {
+            if ( password.size() != length_ ) {
+                if constexpr ( is_debugging_build ) {
+                    std::print( "The password length does not match the policy.\n" );
+                    std::terminate();
+                } else {
+                    std::unreachable();
+                }
+            }
+            auto& engine{ symbols.engine() };
+            auto state{ initial_state_ };
+            while ( state != 0 ) {
+                const auto& thresholds{ thresholds_[ ( password.size() - 1 ) * num_of_states_ + state ] };
+                const auto class_word{ static_cast< std::uint64_t >( engine() ) >> 1 };
+                std::size_t class_index{ 0 };
+                while ( class_word >= thresholds[ class_index ] ) {
+                    ++class_index;
+                }
+                const auto& class_symbols{ symbols_[ class_index ] };
+                const auto symbol_word{ static_cast< std::uint64_t >( engine() ) };
+                const auto size{ static_cast< std::uint64_t >( class_symbols.size() ) };
+                const auto symbol_index{
+                  ( ( symbol_word >> 32 ) * size + ( ( symbol_word & 0xffff'ffffull ) * size >> 32 ) ) >> 32 };
+                password.front() = class_symbols[ symbol_index ];
+                password         = password.subspan( 1 );
+                state            = transitions_[ state ][ class_index ];
+            }
+            symbols.read( password );
+        }
+        friend auto make_password_policy( unsigned classes, const std::array< std::size_t, 4 >& minimums, std::size_t length )
+          -> std::optional< password_policy >;
+    };
+    inline auto make_password_policy(
+      const unsigned classes, const std::array< std::size_t, 4 >& minimums, const std::size_t length )
+      -> std::optional< password_policy >
+    {
+        std::size_t num_of_states{ 1 };
+        std::size_t total_minimum{ 0 };
+        for ( std::size_t i{ 0 }; i < minimums.size(); ++i ) {
+            if ( ( minimums[ i ] != 0 && !( classes & ( 1u << i ) ) ) || minimums[ i ] > length - total_minimum
+                 || num_of_states > password_policy::max_table_size_ / ( minimums[ i ] + 1 ) )
+            {
+                return std::nullopt;
+            }
+            total_minimum += minimums[ i ];
+            num_of_states *= minimums[ i ] + 1;
+        }
+        if ( classes == 0 || length == 0 || num_of_states > password_policy::max_table_size_ / length ) {
+            return std::nullopt;
+        }
+        password_policy policy{ classes, minimums, length };
+        if ( !policy.build_tables_() ) {
+            return std::nullopt;
+        }
+        return policy;
+    }
+    namespace details
+    {
+        inline constexpr std::string_view pattern_tokens{ "ULlD9SACcVv" };
+        inline auto make_pattern_sampler( const char token, const unsigned classes ) -> std::optional< symbol_sampler >
+        {
+            const auto has_capital_letters{ ( classes & character_class::capital_letters ) != 0 };
+            const auto has_lowercase_letters{ ( classes & character_class::lowercase_letters ) != 0 };
+            auto make_sampler{ []( const bool is_allowed, const std::string_view symbols ) noexcept
+            { return is_allowed ? std::optional< symbol_sampler >{ symbols } : std::nullopt; } };
+            switch ( token ) {
+                case 'U' : return make_sampler( has_capital_letters, character_set::capital_letters );
+                case 'L' :
+                    return cpp_utils::make_password_sampler(
+                      classes & ( character_class::capital_letters | character_class::lowercase_letters ) );
+                case 'l' : return make_sampler( has_lowercase_letters, character_set::lowercase_letters );
+                case 'D' :
+                case '9' : return make_sampler( ( classes & character_class::numbers ) != 0, character_set::numbers );
+                case 'S' :
+                    return make_sampler(
+                      ( classes & character_class::special_characters ) != 0, character_set::special_characters );
+                case 'C' : return make_sampler( has_capital_letters, character_set::capital_consonants );
+                case 'c' : return make_sampler( has_lowercase_letters, character_set::lowercase_consonants );
+                case 'V' : return make_sampler( has_capital_letters, character_set::capital_vowels );
+                case 'v' : return make_sampler( has_lowercase_letters, character_set::lowercase_vowels );
+                default : return cpp_utils::make_password_sampler( classes );
+            }
+        }
+    }
+    class password_pattern final
+    {
+      private:
+        struct run_ final
+        {
+            std::size_t offset;
+            std::size_t size;
+            std::size_t dictionary;
+        };
+        std::vector< char > template_{};
+        std::vector< run_ > runs_{};
+        std::vector< symbol_sampler > samplers_{};
+        double log_num_of_candidates_{ 0.0 };
+        password_pattern() noexcept = default;
+      public:
+        auto size() const noexcept
+        {
+            return template_.size();
+        }
+        auto log_num_of_candidates() const noexcept
+        {
+            return log_num_of_candidates_;
+        }
+        auto make_symbol_buffers() const
+        {
+            std::vector< symbol_buffer > buffers;
+            buffers.reserve( samplers_.size() );
+            for ( const auto& sampler : samplers_ ) {
+                buffers.emplace_back( sampler );
+            }
+            return buffers;
+        }
+        template < uniform_64_bit_engine Engine >
+        auto generate(
+          const std::span< char > password, const std::span< symbol_buffer > buffers, Engine& engine ) const noexcept
+        {
+            if ( password.size() != template_.size() || buffers.size() != samplers_.size() ) {
+                if constexpr ( is_debugging_build ) {
+                    std::print( "The password or the symbol buffers do not match the pattern.\n" );
+                    std::terminate();
+                } else {
+                    std::unreachable();
+                }
+            }
+            std::ranges::copy( template_, password.begin() );
+            for ( const auto& run : runs_ ) {
+                buffers[ run.dictionary ].read( password.subspan( run.offset, run.size ), engine );
+            }
+        }
+        friend auto make_password_pattern( std::string_view pattern, unsigned classes ) -> std::optional< password_pattern >;
+    };
+    inline auto make_password_pattern( const std::string_view pattern, const unsigned classes )
+      -> std::optional< password_pattern >
+    {
+        password_pattern result;
+        std::vector< char > dictionary_tokens;
+        for ( std::size_t i{ 0 }; i < pattern.size(); ++i ) {
+            const auto token{ pattern[ i ] };
+            if ( token == '\\' ) {
+                if ( ++i == pattern.size() ) {
+                    return std::nullopt;
+                }
+                result.template_.emplace_back( pattern[ i ] );
+                continue;
+            }
+            if ( !details::pattern_tokens.contains( token ) ) {
+                result.template_.emplace_back( token );
+                continue;
+            }
+            auto dictionary{
+              static_cast< std::size_t >( std::ranges::find( dictionary_tokens, token ) - dictionary_tokens.begin() ) };
+            if ( dictionary == dictionary_tokens.size() ) {
+                auto sampler{ details::make_pattern_sampler( token, classes ) };
+                if ( !sampler.has_value() ) {
+                    return std::nullopt;
+                }
+                dictionary_tokens.emplace_back( token );
+                result.samplers_.emplace_back( *sampler );
+            }
+            result.log_num_of_candidates_ += std::log( static_cast< double >( result.samplers_[ dictionary ].size() ) );
+            const auto offset{ result.template_.size() };
+            result.template_.emplace_back( token );
+            auto& runs{ result.runs_ };
+            if ( !runs.empty() && runs.back().dictionary == dictionary && runs.back().offset + runs.back().size == offset ) {
+                ++runs.back().size;
+            } else {
+                runs.emplace_back( offset, 1uz, dictionary );
+            }
+        }
+        if ( result.template_.empty() ) {
+            return std::nullopt;
+        }
+        return result;
+    }
+    inline auto is_valid_utf8( const std::string_view text ) noexcept
+    {
+        for ( std::size_t i{ 0 }; i < text.size(); ) {
+            const auto lead{ static_cast< unsigned char >( text[ i ] ) };
+            if ( lead < 0x80 ) {
+                ++i;
+                continue;
+            }
+            const auto size{ lead >= 0xf0 ? 4uz : lead >= 0xe0 ? 3uz : 2uz };
+            if ( lead < 0xc2 || lead > 0xf4 || text.size() - i < size ) {
+                return false;
+            }
+            const auto second{ static_cast< unsigned char >( text[ i + 1 ] ) };
+            const auto min_second{ lead == 0xe0 ? 0xa0u : lead == 0xf0 ? 0x90u : 0x80u };
+            const auto max_second{ lead == 0xed ? 0x9fu : lead == 0xf4 ? 0x8fu : 0xbfu };
+            if ( second < min_second || second > max_second ) {
+                return false;
+            }
+            for ( std::size_t j{ 2 }; j < size; ++j ) {
+                if ( ( static_cast< unsigned char >( text[ i + j ] ) & 0xc0 ) != 0x80 ) {
+                    return false;
+                }
+            }
+            i += size;
+        }
+        return true;
+    }
+    class wordlist final
+    {
+      private:
+        static constexpr std::size_t max_word_size_{ 255 };
+        std::span< const char > data_;
+        std::vector< std::uint32_t > offsets_{};
+        std::vector< std::uint8_t > sizes_{};
+        std::optional< alias_table > weights_{};
+        uniform_index_sampler< std::uint32_t > index_sampler_{ 1 };
+        std::size_t longest_word_size_{ 0 };
+        wordlist( const std::span< const char > data ) noexcept
+          : data_{ data }
+        { }
+      public:
+        auto size() const noexcept
+        {
+            return offsets_.size();
+        }
+        auto longest_word_size() const noexcept
+        {
+            return longest_word_size_;
+        }
+        auto is_weighted() const noexcept
+        {
+            return weights_.has_value();
+        }
+        auto word( const std::size_t index ) const noexcept
+        {
+            return std::string_view{ data_.data() + offsets_[ index ], sizes_[ index ] };
+        }
+        template < uniform_64_bit_engine Engine >
+        auto sample( Engine& engine ) const noexcept
+        {
+            if ( weights_.has_value() ) {
+                return word( ( *weights_ )( engine ) );
+            }
+            while ( true ) {
+                const auto [ index, accepted ]{ index_sampler_.reduce( static_cast< std::uint32_t >( engine() ) ) };
+                if ( accepted ) {
+                    return word( index );
+                }
+            }
+        }
+        friend auto make_wordlist( std::span< const char > data ) -> std::optional< wordlist >;
+    };
+    inline auto make_wordlist( const std::span< const char > data ) -> std::optional< wordlist >
+    {
+        if ( data.size() > std::numeric_limits< std::uint32_t >::max() ) {
+            return std::nullopt;
+        }
+        wordlist result{ data };
+        std::vector< double > weights;
+        auto has_weights{ false };
+        for ( std::size_t offset{ 0 }; offset < data.size(); ) {
+            const auto rest{ std::string_view{ data.data() + offset, data.size() - offset } };
+            const auto line_size{ std::ranges::min( rest.find( '\n' ), rest.size() ) };
+            auto line{ rest.substr( 0, line_size ) };
+            const auto line_offset{ offset };
+            offset += line_size + 1;
+            if ( line.ends_with( '\r' ) ) {
+                line.remove_suffix( 1 );
+            }
+            if ( line.empty() ) {
+                continue;
+            }
+            const auto tab{ line.find( '\t' ) };
+            const auto word{ line.substr( 0, tab ) };
+            double weight{ 1.0 };
+            if ( tab != std::string_view::npos ) {
+                const auto text{ line.substr( tab + 1 ) };
+                const auto [ end, error ]{ std::from_chars( text.data(), text.data() + text.size(), weight ) };
+                if ( error != std::errc{} || end != text.data() + text.size() || !( weight > 0.0 ) || !std::isfinite( weight ) )
+                {
+                    return std::nullopt;
+                }
+                has_weights = true;
+            }
+            if ( word.empty() || word.size() > wordlist::max_word_size_ || !is_valid_utf8( word )
+                 || result.offsets_.size() == std::numeric_limits< std::uint32_t >::max() )
+            {
+                return std::nullopt;
+            }
+            result.offsets_.emplace_back( static_cast< std::uint32_t >( line_offset ) );
+            result.sizes_.emplace_back( static_cast< std::uint8_t >( word.size() ) );
+            result.longest_word_size_ = std::ranges::max( result.longest_word_size_, word.size() );
+            weights.emplace_back( weight );
+        }
+        if ( result.offsets_.empty() ) {
+            return std::nullopt;
+        }
+        result.index_sampler_ = uniform_index_sampler< std::uint32_t >{ static_cast< std::uint32_t >( result.offsets_.size() ) };
+        if ( has_weights ) {
+            result.weights_.emplace( weights );
+        }
+        return result;
+    }
+    class concurrent_fingerprint_set final
+    {
+      private:
+        std::size_t capacity_;
+        int index_shift_;
+        std::unique_ptr< std::atomic< std::uint64_t >[] > slots_;
+      public:
+        auto capacity() const noexcept
+        {
+            return capacity_;
+        }
+        auto memory_size() const noexcept
+        {
+            return capacity_ * sizeof( std::atomic< std::uint64_t > );
+        }
+        auto insert( const std::uint64_t hash ) noexcept
+        {
+            const auto fingerprint{ std::ranges::max( hash, std::uint64_t{ 1 } ) };
+            auto index{ static_cast< std::size_t >( hash >> index_shift_ ) };
+            for ( std::size_t probe{ 0 }; probe < capacity_; ++probe, index = ( index + 1 ) & ( capacity_ - 1 ) ) {
+                auto& slot{ slots_[ index ] };
+                auto current{ slot.load( std::memory_order_relaxed ) };
+                if ( current == 0 && slot.compare_exchange_strong( current, fingerprint, std::memory_order_relaxed ) ) {
+                    return true;
+                }
+                if ( current == fingerprint ) {
+                    return false;
+                }
+            }
+            return false;
+        }
+        auto operator=( const concurrent_fingerprint_set& ) -> concurrent_fingerprint_set& = delete;
+        auto operator=( concurrent_fingerprint_set&& ) -> concurrent_fingerprint_set&      = delete;
+        concurrent_fingerprint_set( const std::size_t expected_size )
+          : capacity_{ std::bit_ceil( std::ranges::max( expected_size + expected_size / 3, 64uz ) ) }
+          , index_shift_{ 64 - std::countr_zero( capacity_ ) }
+          , slots_{ std::make_unique< std::atomic< std::uint64_t >[] >( capacity_ ) }
+        { }
+        concurrent_fingerprint_set( const concurrent_fingerprint_set& ) = delete;
+        concurrent_fingerprint_set( concurrent_fingerprint_set&& )      = delete;
+        ~concurrent_fingerprint_set()                                   = default;
+    };
+    class unique_password_set final
+    {
+      private:
+        std::uint64_t key_;
+        concurrent_fingerprint_set fingerprints_;
+        auto hash_( const std::string_view password ) const noexcept
+        {
+            constexpr std::uint64_t multiplier{ 0xbf58'476d'1ce4'e5b9ull };
+            auto hash{ key_ ^ ( password.size() * 0x9e37'79b9'7f4a'7c15ull ) };
+            for ( std::size_t offset{ 0 }; offset < password.size(); offset += sizeof( std::uint64_t ) ) {
+                std::uint64_t word{ 0 };
+                std::memcpy( &word, password.data() + offset, std::ranges::min( sizeof( word ), password.size() - offset ) );
+                hash = ( hash ^ word ) * multiplier;
+                hash ^= hash >> 31;
+            }
+            hash ^= hash >> 33;
+            hash *= 0xff51'afd7'ed55'8ccdull;
+            hash ^= hash >> 33;
+            hash *= 0xc4ce'b9fe'1a85'ec53ull;
+            hash ^= hash >> 33;
+            return hash;
+        }
+      public:
+        auto memory_size() const noexcept
+        {
+            return fingerprints_.memory_size();
+        }
+        auto insert( const std::string_view password ) noexcept
+        {
+            return fingerprints_.insert( hash_( password ) );
+        }
+        auto operator=( const unique_password_set& ) -> unique_password_set& = delete;
+        auto operator=( unique_password_set&& ) -> unique_password_set&      = delete;
+        unique_password_set( const std::size_t expected_size, const std::uint64_t key )
+          : key_{ key }
+          , fingerprints_{ expected_size }
+        { }
+        unique_password_set( const unique_password_set& ) = delete;
+        unique_password_set( unique_password_set&& )      = delete;
+        ~unique_password_set() noexcept
+        {
+            secure_zero( std::as_writable_bytes( std::span{ &key_, 1 } ) );
+        }
+    };
+    enum class output_format : std::uint8_t
+    {
+        lines,
+        ndjson,
+        csv,
+        fixed
+    };
+    inline auto parse_output_format( const std::string_view name ) noexcept -> std::optional< output_format >
+    {
+        if ( name == "lines" ) {
+            return output_format::lines;
+        }
+        if ( name == "ndjson" ) {
+            return output_format::ndjson;
+        }
+        if ( name == "csv" ) {
+            return output_format::csv;
+        }
+        if ( name == "fixed" ) {
+            return output_format::fixed;
+        }
+        return std::nullopt;
+    }
+    struct password_options final
+    {
+        unique_password_set* unique_set{ nullptr };
+        bool score{ false };
+        output_format format{ output_format::lines };
+        std::optional< std::uint64_t > first_index{};
+        std::optional< hash_algorithm > hash{};
+        const binary_fuse_filter* deny_filter{ nullptr };
+    };
+    namespace details
+    {
+        inline constexpr std::string_view ndjson_record_prefix{ "{\"password\":\"" };
+        inline constexpr std::string_view ndjson_score_prefix{ ",\"bits\":" };
+        inline constexpr std::size_t fixed_record_alignment{ 16 };
+        inline constexpr std::size_t hash_hex_size{ hash_digest_size * 2 };
+        inline auto hash_field_size( const password_options& options ) noexcept -> std::size_t
+        {
+            if ( !options.hash.has_value() ) {
+                return 0;
+            }
+            switch ( options.format ) {
+                case output_format::ndjson : return hash_algorithm_name( *options.hash ).size() + hash_hex_size + 6;
+                case output_format::fixed : return hash_digest_size;
+                default : return hash_hex_size + 1;
+            }
+        }
+        inline constexpr std::size_t max_deny_attempts{ 1024 };
+        inline auto deny_filter_key( const hash_digest& digest ) noexcept
+        {
+            std::uint64_t key;
+            std::memcpy( &key, digest.data(), sizeof( key ) );
+            return key;
+        }
+        inline auto password_offset( const output_format format ) noexcept -> std::size_t
+        {
+            switch ( format ) {
+                case output_format::ndjson : return ndjson_record_prefix.size();
+                case output_format::fixed : return 1;
+                default : return 0;
+            }
+        }
+        inline auto escape_json_in_place( char* const text, const std::size_t size ) noexcept
+        {
+            auto escaped_size{ size };
+            for ( std::size_t i{ 0 }; i < size; ++i ) {
+                const auto c{ static_cast< unsigned char >( text[ i ] ) };
+                escaped_size += c == '"' || c == '\\' ? 1 : c < 0x20 ? 5 : 0;
+            }
+            if ( escaped_size == size ) {
+                return size;
+            }
+            constexpr std::string_view hex_digits{ "0123456789abcdef" };
+            auto out{ escaped_size };
+            for ( auto i{ size }; i > 0; --i ) {
+                const auto c{ static_cast< unsigned char >( text[ i - 1 ] ) };
+                if ( c == '"' || c == '\\' ) {
+                    text[ --out ] = static_cast< char >( c );
+                    text[ --out ] = '\\';
+                } else if ( c < 0x20 ) {
+                    text[ --out ] = hex_digits[ c & 0xf ];
+                    text[ --out ] = hex_digits[ c >> 4 ];
+                    text[ --out ] = '0';
+                    text[ --out ] = '0';
+                    text[ --out ] = 'u';
+                    text[ --out ] = '\\';
+                } else {
+                    text[ --out ] = static_cast< char >( c );
+                }
+            }
+            return escaped_size;
+        }
+        inline auto quote_csv_in_place( char* const text, const std::size_t size ) noexcept
+        {
+            std::size_t num_of_quotes{ 0 };
+            auto needs_quotes{ false };
+            for ( std::size_t i{ 0 }; i < size; ++i ) {
+                const auto c{ text[ i ] };
+                num_of_quotes += c == '"' ? 1 : 0;
+                needs_quotes = needs_quotes || c == '"' || c == ',' || c == '\r' || c == '\n';
+            }
+            if ( !needs_quotes ) {
+                return size;
+            }
+            const auto quoted_size{ size + num_of_quotes + 2 };
+            auto out{ quoted_size };
+            text[ --out ] = '"';
+            for ( auto i{ size }; i > 0; --i ) {
+                text[ --out ] = text[ i - 1 ];
+                if ( text[ i - 1 ] == '"' ) {
+                    text[ --out ] = '"';
+                }
+            }
+            text[ --out ] = '"';
+            return quoted_size;
+        }
+    }
+    inline auto is_output_format_supported( const std::size_t max_password_size, const password_options& options ) noexcept
+    {
+        return options.format != output_format::fixed
+            || ( !options.score && max_password_size <= std::numeric_limits< std::uint8_t >::max() );
+    }
+    inline auto password_record_size( const std::size_t max_password_size, const password_options& options ) noexcept
+    {
+        const auto score_field_size{ options.score ? password_score_field_size( max_password_size ) : 0 };
+        const auto hash_field_size{ details::hash_field_size( options ) };
+        switch ( options.format ) {
+            case output_format::ndjson :
+                return details::ndjson_record_prefix.size() + max_password_size * 6 + 1
+                     + ( options.score ? details::ndjson_score_prefix.size() + score_field_size - 1 : 0 ) + hash_field_size + 2;
+            case output_format::csv : return max_password_size * 2 + 2 + score_field_size + hash_field_size + 1;
+            case output_format::fixed :
+                return ( max_password_size + details::fixed_record_alignment ) / details::fixed_record_alignment
+                     * details::fixed_record_alignment
+                     + hash_field_size;
+            default : return max_password_size + score_field_size + hash_field_size + 1;
+        }
+    }
+    inline auto write_output_header( output_buffer& buffer, const password_options& options )
+    {
+        if ( options.format != output_format::csv ) {
+            return;
+        }
+        buffer.write( options.score ? "password,bits" : "password" );
+        if ( options.hash.has_value() ) {
+            buffer.write( "," );
+            buffer.write( hash_algorithm_name( *options.hash ) );
+        }
+        buffer.write( "\n" );
+    }
+    inline auto finish_password_record(
+      const std::span< char > record, const std::size_t password_size, const std::size_t max_password_size,
+      const password_options& options, const hash_digest* const digest = nullptr ) noexcept -> std::size_t
+    {
+        const auto offset{ details::password_offset( options.format ) };
+        const auto score{
+          options.score ? score_password( std::string_view{ record.data() + offset, password_size } ) : password_score{} };
+        std::size_t size{ 0 };
+        switch ( options.format ) {
+            case output_format::lines :
+                size = password_size;
+                if ( options.score ) {
+                    const auto score_field_size{ password_score_field_size( max_password_size ) };
+                    write_password_score( record.subspan( size, score_field_size ), score );
+                    size += score_field_size;
+                }
+                if ( digest != nullptr ) {
+                    record[ size++ ] = '\t';
+                    write_hash_hex( record.subspan( size, details::hash_hex_size ), *digest );
+                    size += details::hash_hex_size;
+                }
+                record[ size++ ] = '\n';
+                return size;
+            case output_format::ndjson :
+                std::ranges::copy( details::ndjson_record_prefix, record.data() );
+                size = offset + details::escape_json_in_place( record.data() + offset, password_size );
+                record[ size++ ] = '"';
+                if ( options.score ) {
+                    std::ranges::copy( details::ndjson_score_prefix, record.data() + size );
+                    size += details::ndjson_score_prefix.size();
+                    size += write_password_score_bits( record.subspan( size ), score );
+                }
+                if ( digest != nullptr ) {
+                    const auto name{ hash_algorithm_name( *options.hash ) };
+                    record[ size++ ] = ',';
+                    record[ size++ ] = '"';
+                    std::ranges::copy( name, record.data() + size );
+                    size += name.size();
+                    record[ size++ ] = '"';
+                    record[ size++ ] = ':';
+                    record[ size++ ] = '"';
+                    write_hash_hex( record.subspan( size, details::hash_hex_size ), *digest );
+                    size += details::hash_hex_size;
+                    record[ size++ ] = '"';
+                }
+                record[ size++ ] = '}';
+                record[ size++ ] = '\n';
+                return size;
+            case output_format::csv :
+                size = details::quote_csv_in_place( record.data(), password_size );
+                if ( options.score ) {
+                    record[ size++ ] = ',';
+                    size += write_password_score_bits( record.subspan( size ), score );
+                }
+                if ( digest != nullptr ) {
+                    record[ size++ ] = ',';
+                    write_hash_hex( record.subspan( size, details::hash_hex_size ), *digest );
+                    size += details::hash_hex_size;
+                }
+                record[ size++ ] = '\n';
+                return size;
+            case output_format::fixed : {
+                size = password_record_size( max_password_size, options );
+                const auto padding_end{ size - ( digest != nullptr ? hash_digest_size : 0 ) };
+                record.front() = static_cast< char >( password_size );
+                std::ranges::fill( record.subspan( offset + password_size, padding_end - offset - password_size ), '\0' );
+                if ( digest != nullptr ) {
+                    std::memcpy( record.data() + padding_end, digest->data(), digest->size() );
+                }
+                return size;
+            }
+        }
+        std::unreachable();
+    }
+    struct password_rules final
+    {
+        std::shared_ptr< const password_policy > policy{};
+        std::shared_ptr< const password_pattern > pattern{};
+    };
+    namespace details
+    {
+        inline constexpr std::size_t seeked_refill_size{ 64 };
+    }
+    template < uniform_64_bit_engine Engine >
+    class password_engine final
+    {
+      private:
+        symbol_stream< Engine > symbols_;
+        password_rules rules_;
+        std::vector< symbol_buffer > pattern_symbols_;
+        auto fixed_length_() const noexcept -> std::size_t
+        {
+            if ( rules_.pattern != nullptr ) {
+                return rules_.pattern->size();
+            }
+            return rules_.policy != nullptr ? rules_.policy->length() : 0;
+        }
+        auto generate_( const std::span< char > password ) noexcept
+        {
+            if ( rules_.pattern != nullptr ) {
+                rules_.pattern->generate( password, pattern_symbols_, symbols_.engine() );
+            } else if ( rules_.policy != nullptr ) {
+                rules_.policy->generate( password, symbols_ );
+            } else {
+                symbols_.read( password );
+            }
+        }
+      public:
+        auto random_engine() noexcept -> Engine&
+        {
+            return symbols_.engine();
+        }
+        auto rules() const noexcept -> const password_rules&
+        {
+            return rules_;
+        }
+        auto seek( const std::uint64_t index, const std::uint64_t attempt = 0 ) noexcept
+            requires requires( Engine& engine ) {
+                engine.restart( std::uint64_t{} );
+                engine.seek( std::uint64_t{} );
+            }
+        {
+            symbols_.engine().restart( index );
+            symbols_.engine().seek( attempt << 32 );
+            symbols_.reset( details::seeked_refill_size );
+            for ( auto& buffer : pattern_symbols_ ) {
+                buffer.reset( details::seeked_refill_size );
+            }
+        }
+        auto generate_into( const std::span< char > password ) noexcept
+        {
+            const auto fixed_length{ fixed_length_() };
+            if ( fixed_length != 0 && password.size() != fixed_length ) {
+                return false;
+            }
+            generate_( password );
+            return true;
+        }
+        auto generate_many( const std::span< char > out, const std::size_t length, const std::size_t count ) noexcept
+        {
+            const auto fixed_length{ fixed_length_() };
+            if ( length == 0 || out.size() / length < count || ( fixed_length != 0 && length != fixed_length ) ) {
+                return false;
+            }
+            if ( fixed_length == 0 ) {
+                symbols_.read( out.first( length * count ) );
+                return true;
+            }
+            for ( std::size_t i{ 0 }; i < count; ++i ) {
+                generate_( out.subspan( i * length, length ) );
+            }
+            return true;
+        }
+#if defined( __cpp_lib_generator )
+        auto generate_stream( const std::span< char > password, const std::size_t count )
+          -> std::generator< std::string_view >
+        {
+            for ( std::size_t i{ 0 }; i < count && generate_into( password ); ++i ) {
+                co_yield std::string_view{ password.data(), password.size() };
+            }
+        }
+#endif
+        auto operator=( const password_engine< Engine >& ) -> password_engine< Engine >& = delete;
+        auto operator=( password_engine< Engine >&& ) -> password_engine< Engine >&      = default;
+        password_engine( Engine engine, const symbol_sampler& sampler, password_rules rules )
+          : symbols_{ std::move( engine ), sampler }
+          , rules_{ std::move( rules ) }
+          , pattern_symbols_{
+              rules_.pattern != nullptr ? rules_.pattern->make_symbol_buffers() : std::vector< symbol_buffer >{} }
+        { }
+        password_engine( const password_engine< Engine >& )     = delete;
+        password_engine( password_engine< Engine >&& ) noexcept = default;
+    };
+    template < uniform_64_bit_engine Engine >
+    inline auto make_password_engine(
+      Engine engine, const unsigned classes, const std::array< std::size_t, 4 >& minimums, const std::size_t length )
+      -> std::optional< password_engine< Engine > >
+    {
+        const auto sampler{ make_password_sampler( classes ) };
+        if ( !sampler.has_value() ) {
+            return std::nullopt;
+        }
+        password_rules rules;
+        if ( std::ranges::any_of( minimums, []( const std::size_t minimum ) noexcept { return minimum != 0; } ) ) {
+            auto policy{ make_password_policy( classes, minimums, length ) };
+            if ( !policy.has_value() ) {
+                return std::nullopt;
+            }
+            rules.policy = std::make_shared< const password_policy >( std::move( *policy ) );
+        }
+        return password_engine< Engine >{ std::move( engine ), *sampler, std::move( rules ) };
+    }
+    template < uniform_64_bit_engine Engine >
+    inline auto make_password_engine( Engine engine, const std::string_view pattern, const unsigned classes )
+      -> std::optional< password_engine< Engine > >
+    {
+        const auto sampler{ make_password_sampler( classes ) };
+        auto compiled_pattern{ make_password_pattern( pattern, classes ) };
+        if ( !sampler.has_value() || !compiled_pattern.has_value() ) {
+            return std::nullopt;
+        }
+        password_rules rules;
+        rules.pattern = std::make_shared< const password_pattern >( std::move( *compiled_pattern ) );
+        return password_engine< Engine >{ std::move( engine ), *sampler, std::move( rules ) };
+    }
+    template < typename Engine >
+    struct password_worker final
+    {
+        std::size_t index;
+        password_engine< Engine > engine;
+        std::size_t num_of_rejections{ 0 };
+        std::size_t num_of_denials{ 0 };
+    };
+    inline auto make_mt19937_64_password_workers(
+      const std::size_t num_of_workers, const symbol_sampler& sampler, const password_rules& rules )
+    {
+        std::random_device device;
+        std::vector< password_worker< std::mt19937_64 > > workers;
+        workers.reserve( num_of_workers );
+        for ( std::size_t i{ 0 }; i < num_of_workers; ++i ) {
+            std::seed_seq seeds{
+              device(), device(), device(), device(), device(), device(), device(), device(), static_cast< unsigned >( i ) };
+            workers.emplace_back( i, password_engine{ std::mt19937_64{ seeds }, sampler, rules } );
+        }
+        return workers;
+    }
+    inline auto make_chacha20_password_workers(
+      const std::size_t num_of_workers, const symbol_sampler& sampler, const password_rules& rules )
+    {
+        std::vector< password_worker< chacha20_engine > > workers;
+        chacha20_engine::key_type key;
+        if ( !fill_with_entropy( std::as_writable_bytes( std::span{ key } ) ) ) {
+            return workers;
+        }
+        workers.reserve( num_of_workers );
+        for ( std::size_t i{ 0 }; i < num_of_workers; ++i ) {
+            workers.emplace_back( i, password_engine{ chacha20_engine{ key, i }, sampler, rules } );
+        }
+        secure_zero( std::as_writable_bytes( std::span{ key } ) );
+        return workers;
+    }
+    inline auto make_seeded_password_workers(
+      const std::size_t num_of_workers, const symbol_sampler& sampler, const password_rules& rules,
+      const chacha20_engine::key_type& key )
+    {
+        std::vector< password_worker< chacha20_engine > > workers;
+        workers.reserve( num_of_workers );
+        for ( std::size_t i{ 0 }; i < num_of_workers; ++i ) {
+            workers.emplace_back( i, password_engine{ chacha20_engine{ key }, sampler, rules } );
+        }
+        return workers;
+    }
+    inline auto make_pool_password_workers(
+      const std::size_t num_of_workers, const symbol_sampler& sampler, const password_rules& rules, entropy_pool& pool )
+    {
+        std::vector< password_worker< entropy_pool_engine > > workers;
+        workers.reserve( num_of_workers );
+        for ( std::size_t i{ 0 }; i < num_of_workers; ++i ) {
+            workers.emplace_back( i, password_engine{ entropy_pool_engine{ pool }, sampler, rules } );
+        }
+        return workers;
+    }
+    namespace details
+    {
+        template < typename Engine >
+        inline auto seek_record(
+          password_engine< Engine >& engine, const password_options& options, const std::size_t index,
+          const std::size_t attempt ) noexcept
+        {
+            if constexpr ( requires { engine.seek( std::uint64_t{} ); } ) {
+                if ( options.first_index.has_value() ) {
+                    engine.seek( *options.first_index + index, attempt );
+                }
+            }
+        }
+    }
+    template < typename Engine, typename PasswordMaker >
+    inline auto write_records(
+      output_buffer& buffer, std::vector< password_worker< Engine > >& workers, const std::size_t num_of_records,
+      const std::size_t max_password_size, const password_options& options, PasswordMaker&& make_password )
+    {
+        if ( num_of_records == 0 ) {
+            return true;
+        }
+        const auto offset{ details::password_offset( options.format ) };
+        const auto max_record_size{ password_record_size( max_password_size, options ) };
+        const auto records_per_block{
+          std::ranges::min( std::ranges::max( default_pipeline_block_size / max_record_size, 1uz ), num_of_records ) };
+        const auto num_of_blocks{ ( num_of_records + records_per_block - 1 ) / records_per_block };
+        std::optional< message_hasher > hasher;
+        if ( options.hash.has_value() ) {
+            hasher.emplace( *options.hash );
+        }
+        std::optional< message_hasher > deny_hasher;
+        if ( options.deny_filter != nullptr ) {
+            deny_hasher.emplace( hash_algorithm::sha256 );
+        }
+        const auto batch_size{
+          hasher.has_value() ? hasher->lanes() : deny_hasher.has_value() ? deny_hasher->lanes() : 1uz };
+        const auto reuses_deny_digests{ deny_hasher.has_value() && options.hash == hash_algorithm::sha256 };
+        ordered_block_ring ring{
+          std::ranges::min( workers.size() * 2 + 2, num_of_blocks + 1 ), records_per_block * max_record_size };
+        buffer.flush();
+        std::thread writer{ [ & ] noexcept
+        {
+            for ( std::size_t sequence{ 0 }; sequence < num_of_blocks; ++sequence ) {
+                buffer.write_direct( ring.consume( sequence ) );
+                ring.release( sequence );
+            }
+        } };
+        std::atomic< std::size_t > next_block{ 0 };
+        std::atomic< bool > is_complete{ true };
+        parallel_for_each(
+          static_cast< nproc_t >( workers.size() ), workers.begin(), workers.end(),
+          [ & ]( password_worker< Engine >& worker )
+        {
+            std::array< const char*, details::max_hash_lanes > passwords;
+            std::array< std::size_t, details::max_hash_lanes > password_sizes;
+            std::array< hash_digest, details::max_hash_lanes > digests;
+            std::array< hash_digest, details::max_hash_lanes > deny_digests;
+            std::array< bool, details::max_hash_lanes > is_denied{};
+            const auto& emitted_digests{ reuses_deny_digests ? deny_digests : digests };
+            for ( auto sequence{ next_block.fetch_add( 1, std::memory_order_relaxed ) }; sequence < num_of_blocks;
+                  sequence = next_block.fetch_add( 1, std::memory_order_relaxed ) )
+            {
+                const auto block{ ring.acquire( sequence ) };
+                const auto first{ sequence * records_per_block };
+                const auto last{ std::ranges::min( first + records_per_block, num_of_records ) };
+                std::size_t size{ 0 };
+                for ( auto index{ first }; index < last; index += batch_size ) {
+                    const auto count{ std::ranges::min( last - index, batch_size ) };
+                    const auto slot{ [ & ]( const std::size_t i ) noexcept
+                    {
+                        return block.subspan( size + i * max_record_size + offset, max_password_size );
+                    } };
+                    for ( std::size_t i{ 0 }; i < count; ++i ) {
+                        passwords[ i ]      = slot( i ).data();
+                        password_sizes[ i ] = make_password( slot( i ), worker, index + i, 0 );
+                    }
+                    if ( deny_hasher.has_value() ) {
+                        deny_hasher->hash( std::span{ passwords }.first( count ), password_sizes, deny_digests );
+                        for ( std::size_t i{ 0 }; i < count; ++i ) {
+                            is_denied[ i ] = false;
+                            for ( std::size_t attempt{ 1 };
+                                  options.deny_filter->contains( details::deny_filter_key( deny_digests[ i ] ) ); ++attempt )
+                            {
+                                if ( attempt > details::max_deny_attempts ) {
+                                    is_denied[ i ] = true;
+                                    is_complete.store( false, std::memory_order_relaxed );
+                                    break;
+                                }
+                                ++worker.num_of_denials;
+                                password_sizes[ i ] = make_password( slot( i ), worker, index + i, attempt );
+                                deny_digests[ i ] = deny_hasher->hash( std::string_view{ passwords[ i ], password_sizes[ i ] } );
+                            }
+                        }
+                    }
+                    if ( hasher.has_value() && !reuses_deny_digests ) {
+                        hasher->hash( std::span{ passwords }.first( count ), password_sizes, digests );
+                    }
+                    for ( std::size_t i{ 0 }; i < count; ++i ) {
+                        if ( is_denied[ i ] ) {
+                            continue;
+                        }
+                        const auto record{ block.subspan( size, max_record_size ) };
+                        std::memmove( record.data() + offset, passwords[ i ], password_sizes[ i ] );
+                        size += finish_password_record(
+                          record, password_sizes[ i ], max_password_size, options,
+                          hasher.has_value() ? &emitted_digests[ i ] : nullptr );
+                    }
+                }
+                ring.publish( sequence, size );
+            }
+        } );
+        writer.join();
+        return is_complete.load( std::memory_order_relaxed );
+    }
+    template < typename Engine >
+    inline auto write_passwords(
+      output_buffer& buffer, std::vector< password_worker< Engine > >& workers, const std::size_t num_of_passwords,
+      const std::size_t password_length, const password_options& options )
+    {
+        return write_records(
+          buffer, workers, num_of_passwords, password_length, options,
+          [ & ]( const std::span< char > password, password_worker< Engine >& worker, const std::size_t index,
+                 const std::size_t attempt ) noexcept
+        {
+            details::seek_record( worker.engine, options, index, attempt );
+            worker.engine.generate_into( password );
+            while ( options.unique_set != nullptr
+                    && !options.unique_set->insert( std::string_view{ password.data(), password.size() } ) )
+            {
+                ++worker.num_of_rejections;
+                worker.engine.generate_into( password );
+            }
+            return password.size();
+        } );
+    }
+    template < uniform_64_bit_engine Engine >
+    inline auto make_passphrase(
+      const std::span< char > out, const wordlist& words, const std::size_t num_of_words, const std::string_view separator,
+      Engine& engine ) noexcept
+    {
+        std::size_t size{ 0 };
+        for ( std::size_t i{ 0 }; i < num_of_words; ++i ) {
+            if ( i != 0 ) {
+                std::ranges::copy( separator, out.data() + size );
+                size += separator.size();
+            }
+            const auto word{ words.sample( engine ) };
+            std::ranges::copy( word, out.data() + size );
+            size += word.size();
+        }
+        return size;
+    }
+    inline auto
+      max_passphrase_size( const wordlist& words, const std::size_t num_of_words, const std::string_view separator ) noexcept
+    {
+        return num_of_words * words.longest_word_size() + ( num_of_words - 1 ) * separator.size();
+    }
+    inline auto max_passphrase_record_size(
+      const wordlist& words, const std::size_t num_of_words, const std::string_view separator,
+      const password_options& options ) noexcept
+    {
+        return password_record_size( max_passphrase_size( words, num_of_words, separator ), options );
+    }
+    template < typename Engine >
+    inline auto write_passphrases(
+      output_buffer& buffer, std::vector< password_worker< Engine > >& workers, const std::size_t num_of_passphrases,
+      const wordlist& words, const std::size_t num_of_words, const std::string_view separator,
+      const password_options& options )
+    {
+        return write_records(
+          buffer, workers, num_of_passphrases, max_passphrase_size( words, num_of_words, separator ), options,
+          [ & ]( const std::span< char > out, password_worker< Engine >& worker, const std::size_t index,
+                 const std::size_t attempt ) noexcept
+        {
+            details::seek_record( worker.engine, options, index, attempt );
+            auto size{ make_passphrase( out, words, num_of_words, separator, worker.engine.random_engine() ) };
+            while ( options.unique_set != nullptr && !options.unique_set->insert( std::string_view{ out.data(), size } ) ) {
+                ++worker.num_of_rejections;
+                size = make_passphrase( out, words, num_of_words, separator, worker.engine.random_engine() );
+            }
+            return size;
+        } );
+    }
+    namespace details
+    {
+        inline auto parse_hex_digest( const std::string_view text ) noexcept -> std::optional< hash_digest >
+        {
+            if ( text.size() < hash_hex_size || ( text.size() > hash_hex_size && text[ hash_hex_size ] != ':' ) ) {
+                return std::nullopt;
+            }
+            hash_digest digest;
+            for ( std::size_t i{ 0 }; i < digest.size(); ++i ) {
+                std::uint8_t byte;
+                const auto [ end, error ]{ std::from_chars( text.data() + i * 2, text.data() + i * 2 + 2, byte, 16 ) };
+                if ( error != std::errc{} || end != text.data() + i * 2 + 2 ) {
+                    return std::nullopt;
+                }
+                digest[ i ] = std::byte{ byte };
+            }
+            return digest;
+        }
+    }
+    inline auto read_deny_list_keys( std::FILE* const input )
+    {
+        const message_hasher hasher{ hash_algorithm::sha256 };
+        std::vector< std::uint64_t > keys;
+        std::vector< char > text_buffer( default_output_buffer_size );
+        std::vector< const char* > passwords;
+        std::vector< std::size_t > password_sizes;
+        std::vector< hash_digest > digests;
+        std::size_t pending_size{ 0 };
+        for ( auto is_end_of_input{ false }; !is_end_of_input; ) {
+            const auto read_size{
+              std::fread( text_buffer.data() + pending_size, 1, text_buffer.size() - pending_size, input ) };
+            is_end_of_input = read_size == 0;
+            const std::string_view text{ text_buffer.data(), pending_size + read_size };
+            std::size_t consumed_size{ 0 };
+            passwords.clear();
+            password_sizes.clear();
+            while ( consumed_size < text.size() ) {
+                auto line_end{ text.find( '\n', consumed_size ) };
+                if ( line_end == std::string_view::npos && !is_end_of_input ) {
+                    break;
+                }
+                line_end = std::ranges::min( line_end, text.size() );
+                auto line{ text.substr( consumed_size, line_end - consumed_size ) };
+                if ( line.ends_with( '\r' ) ) {
+                    line.remove_suffix( 1 );
+                }
+                consumed_size = line_end + 1;
+                if ( line.empty() ) {
+                    continue;
+                }
+                if ( const auto digest{ details::parse_hex_digest( line ) }; digest.has_value() ) {
+                    keys.emplace_back( details::deny_filter_key( *digest ) );
+                } else {
+                    passwords.emplace_back( line.data() );
+                    password_sizes.emplace_back( line.size() );
+                }
+            }
+            if ( consumed_size == 0 && text.size() == text_buffer.size() ) {
+                text_buffer.resize( text_buffer.size() * 2 );
+                pending_size = text.size();
+                continue;
+            }
+            digests.resize( passwords.size() );
+            hasher.hash( passwords, password_sizes, digests );
+            for ( const auto& digest : digests ) {
+                keys.emplace_back( details::deny_filter_key( digest ) );
+            }
+            pending_size = text.size() - std::ranges::min( consumed_size, text.size() );
+            std::memmove( text_buffer.data(), text.data() + text.size() - pending_size, pending_size );
+        }
+        return keys;
+    }
+    inline auto score_password_lines( std::FILE* const input, output_buffer& buffer )
+    {
+        std::vector< char > text_buffer( default_output_buffer_size );
+        std::vector< std::string_view > lines;
+        std::vector< password_score > scores;
+        std::size_t pending_size{ 0 };
+        for ( auto is_end_of_input{ false }; !is_end_of_input; ) {
+            const auto read_size{ read_available( input, std::span{ text_buffer }.subspan( pending_size ) ) };
+            is_end_of_input = read_size == 0;
+            const std::string_view text{ text_buffer.data(), pending_size + read_size };
+            std::size_t consumed_size{ 0 };
+            lines.clear();
+            while ( consumed_size < text.size() ) {
+                auto line_end{ text.find( '\n', consumed_size ) };
+                if ( line_end == std::string_view::npos && !is_end_of_input ) {
+                    break;
+                }
+                line_end = std::ranges::min( line_end, text.size() );
+                auto line{ text.substr( consumed_size, line_end - consumed_size ) };
+                if ( line.ends_with( '\r' ) ) {
+                    line.remove_suffix( 1 );
+                }
+                lines.emplace_back( line );
+                consumed_size = line_end + 1;
+            }
+            if ( lines.empty() && text.size() == text_buffer.size() ) {
+                text_buffer.resize( text_buffer.size() * 2 );
+                pending_size = text.size();
+                continue;
+            }
+            scores.resize( lines.size() );
+            score_passwords( lines, scores );
+            for ( std::size_t i{ 0 }; i < lines.size(); ++i ) {
+                const auto field_size{ password_score_field_size( lines[ i ].size() ) };
+                buffer.write( lines[ i ] );
+                const auto field{ buffer.acquire( field_size + 1 ) };
+                write_password_score( field.first( field_size ), scores[ i ] );
+                field.back() = '\n';
+                buffer.commit( field.size() );
+            }
+            if ( !lines.empty() ) {
+                buffer.sync();
+            }
+            pending_size = text.size() - std::ranges::min( consumed_size, text.size() );
+            std::memmove( text_buffer.data(), text_buffer.data() + text.size() - pending_size, pending_size );
+        }
+        buffer.flush();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,387 @@
+#pragma once
+#if defined( __linux__ )
+# include <fcntl.h>
+# include <pthread.h>
+# include <sys/epoll.h>
+# include <sys/signalfd.h>
+# include <sys/socket.h>
+# include <sys/stat.h>
+# include <sys/un.h>
+# include <unistd.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "io.hpp"
+#include "password.hpp"
+#include "random.hpp"
+namespace cpp_utils
+{
+#if defined( __linux__ )
+    struct password_request final
+    {
+        std::uint16_t length{ 16 };
+        std::uint16_t count{ 1 };
+        std::uint8_t classes{ character_class::all };
+        std::array< std::uint8_t, 3 > reserved{};
+    };
+    enum class password_response_status : std::uint32_t
+    {
+        ok,
+        invalid_request
+    };
+    struct password_response_header final
+    {
+        password_response_status status;
+        std::uint32_t size;
+    };
+    inline constexpr std::size_t max_served_password_length{ 4096 };
+    inline constexpr std::size_t max_served_response_size{ 1uz << 20 };
+    namespace details
+    {
+        class file_descriptor final
+        {
+          private:
+            int fd_;
+          public:
+            auto get() const noexcept
+            {
+                return fd_;
+            }
+            auto is_valid() const noexcept
+            {
+                return fd_ != -1;
+            }
+            auto reset( const int fd ) noexcept
+            {
+                if ( fd_ != -1 ) {
+                    ::close( fd_ );
+                }
+                fd_ = fd;
+            }
+            auto operator=( const file_descriptor& ) -> file_descriptor& = delete;
+            auto operator=( file_descriptor&& ) -> file_descriptor&      = delete;
+            file_descriptor( const int fd ) noexcept
+              : fd_{ fd }
+            { }
+            file_descriptor( const file_descriptor& ) = delete;
+            file_descriptor( file_descriptor&& )      = delete;
+            ~file_descriptor() noexcept
+            {
+                reset( -1 );
+            }
+        };
+        inline auto make_unix_socket_address( const std::string_view path ) noexcept -> std::optional< sockaddr_un >
+        {
+            sockaddr_un address{};
+            if ( path.empty() || path.size() >= sizeof( address.sun_path ) ) {
+                return std::nullopt;
+            }
+            address.sun_family = AF_UNIX;
+            std::ranges::copy( path, address.sun_path );
+            return address;
+        }
+        inline auto send_all( const int fd, std::span< const std::byte > data ) noexcept
+        {
+            while ( !data.empty() ) {
+                const auto size{ ::send( fd, data.data(), data.size(), MSG_NOSIGNAL ) };
+                if ( size < 0 && errno == EINTR ) {
+                    continue;
+                }
+                if ( size <= 0 ) {
+                    return false;
+                }
+                data = data.subspan( static_cast< std::size_t >( size ) );
+            }
+            return true;
+        }
+        inline auto receive_all( const int fd, std::span< std::byte > data ) noexcept
+        {
+            while ( !data.empty() ) {
+                const auto size{ ::recv( fd, data.data(), data.size(), 0 ) };
+                if ( size < 0 && errno == EINTR ) {
+                    continue;
+                }
+                if ( size <= 0 ) {
+                    return false;
+                }
+                data = data.subspan( static_cast< std::size_t >( size ) );
+            }
+            return true;
+        }
+        inline auto response_payload_size( const password_request& request ) noexcept -> std::optional< std::size_t >
+        {
+            const auto size{ ( static_cast< std::size_t >( request.length ) + 1 ) * request.count };
+            if ( request.length == 0 || request.length > max_served_password_length || request.count == 0
+                 || request.classes == 0 || ( request.classes & ~character_class::all ) != 0
+                 || request.reserved != std::array< std::uint8_t, 3 >{} || size > max_served_response_size )
+            {
+                return std::nullopt;
+            }
+            return size;
+        }
+    }
+    class password_server final
+    {
+      private:
+        static constexpr std::size_t max_events_{ 64 };
+        static constexpr std::size_t max_pending_output_{ 4uz << 20 };
+        struct connection_ final
+        {
+            std::array< std::byte, sizeof( password_request ) > request{};
+            std::size_t request_size{ 0 };
+            std::vector< char > output{};
+            std::size_t output_offset{ 0 };
+            bool is_end_of_input{ false };
+        };
+        std::string path_;
+        details::file_descriptor listener_;
+        details::file_descriptor epoll_;
+        entropy_pool pool_;
+        entropy_pool_engine engine_;
+        std::vector< symbol_buffer > symbols_{};
+        std::unordered_map< int, connection_ > connections_{};
+        std::array< std::byte, 1uz << 16 > input_{};
+        auto watch_( const int fd, const std::uint32_t events, const int operation ) const noexcept
+        {
+            epoll_event event{};
+            event.events  = events;
+            event.data.fd = fd;
+            return ::epoll_ctl( epoll_.get(), operation, fd, &event ) == 0;
+        }
+        auto close_( const int fd ) noexcept
+        {
+            ::epoll_ctl( epoll_.get(), EPOLL_CTL_DEL, fd, nullptr );
+            ::close( fd );
+            connections_.erase( fd );
+        }
+        auto accept_() noexcept
+        {
+            while ( true ) {
+                const auto fd{ ::accept4( listener_.get(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC ) };
+                if ( fd == -1 ) {
+                    return;
+                }
+                if ( !watch_( fd, EPOLLIN, EPOLL_CTL_ADD ) ) {
+                    ::close( fd );
+                    continue;
+                }
+                connections_.emplace( fd, connection_{} );
+            }
+        }
+        auto respond_( connection_& connection, const password_request& request )
+        {
+            const auto payload_size{ details::response_payload_size( request ) };
+            const password_response_header header{
+              payload_size.has_value() ? password_response_status::ok : password_response_status::invalid_request,
+              static_cast< std::uint32_t >( payload_size.value_or( 0 ) ) };
+            auto& output{ connection.output };
+            const auto offset{ output.size() };
+            output.resize( offset + sizeof( header ) + header.size );
+            std::memcpy( output.data() + offset, &header, sizeof( header ) );
+            if ( !payload_size.has_value() ) {
+                return;
+            }
+            auto& symbols{ symbols_[ request.classes - 1 ] };
+            const std::span payload{ output.data() + offset + sizeof( header ), header.size };
+            for ( std::size_t i{ 0 }; i < request.count; ++i ) {
+                const auto record{ payload.subspan( i * ( request.length + 1uz ), request.length + 1uz ) };
+                symbols.read( record.first( request.length ), engine_ );
+                record.back() = '\n';
+            }
+        }
+        auto flush_( const int fd, connection_& connection ) noexcept
+        {
+            auto& output{ connection.output };
+            while ( connection.output_offset < output.size() ) {
+                const auto size{ ::send(
+                  fd, output.data() + connection.output_offset, output.size() - connection.output_offset, MSG_NOSIGNAL ) };
+                if ( size < 0 && errno == EINTR ) {
+                    continue;
+                }
+                if ( size < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ) {
+                    return watch_( fd, EPOLLOUT, EPOLL_CTL_MOD );
+                }
+                if ( size <= 0 ) {
+                    return false;
+                }
+                connection.output_offset += static_cast< std::size_t >( size );
+            }
+            output.clear();
+            connection.output_offset = 0;
+            return !connection.is_end_of_input && watch_( fd, EPOLLIN, EPOLL_CTL_MOD );
+        }
+        auto receive_( const int fd, connection_& connection )
+        {
+            while ( connection.output.size() < max_pending_output_ ) {
+                const auto size{ ::recv( fd, input_.data(), input_.size(), 0 ) };
+                if ( size < 0 && errno == EINTR ) {
+                    continue;
+                }
+                if ( size < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ) {
+                    break;
+                }
+                if ( size < 0 ) {
+                    return false;
+                }
+                if ( size == 0 ) {
+                    connection.is_end_of_input = true;
+                    break;
+                }
+                for ( std::span input{ input_.data(), static_cast< std::size_t >( size ) }; !input.empty(); ) {
+                    const auto copy_size{
+                      std::ranges::min( input.size(), connection.request.size() - connection.request_size ) };
+                    std::ranges::copy( input.first( copy_size ), connection.request.begin() + connection.request_size );
+                    connection.request_size += copy_size;
+                    input = input.subspan( copy_size );
+                    if ( connection.request_size == connection.request.size() ) {
+                        password_request request;
+                        std::memcpy( &request, connection.request.data(), sizeof( request ) );
+                        respond_( connection, request );
+                        connection.request_size = 0;
+                    }
+                }
+            }
+            return flush_( fd, connection );
+        }
+      public:
+        auto is_listening() const noexcept
+        {
+            return epoll_.is_valid() && pool_.is_ready();
+        }
+        auto run()
+        {
+            sigset_t signals;
+            ::sigemptyset( &signals );
+            ::sigaddset( &signals, SIGINT );
+            ::sigaddset( &signals, SIGTERM );
+            if ( ::pthread_sigmask( SIG_BLOCK, &signals, nullptr ) != 0 ) {
+                return false;
+            }
+            const details::file_descriptor signal_fd{ ::signalfd( -1, &signals, SFD_NONBLOCK | SFD_CLOEXEC ) };
+            if ( !signal_fd.is_valid() || !watch_( signal_fd.get(), EPOLLIN, EPOLL_CTL_ADD ) ) {
+                return false;
+            }
+            std::array< epoll_event, max_events_ > events;
+            while ( true ) {
+                const auto num_of_events{ ::epoll_wait( epoll_.get(), events.data(), max_events_, -1 ) };
+                if ( num_of_events < 0 && errno == EINTR ) {
+                    continue;
+                }
+                if ( num_of_events < 0 ) {
+                    return false;
+                }
+                for ( const auto& event : std::span{ events.data(), static_cast< std::size_t >( num_of_events ) } ) {
+                    const auto fd{ event.data.fd };
+                    if ( fd == signal_fd.get() ) {
+                        return true;
+                    }
+                    if ( fd == listener_.get() ) {
+                        accept_();
+                        continue;
+                    }
+                    auto& connection{ connections_[ fd ] };
+                    const auto is_alive{
+                      ( event.events & ( EPOLLERR | EPOLLHUP ) ) == 0
+                      && ( event.events & EPOLLOUT ? flush_( fd, connection ) : receive_( fd, connection ) ) };
+                    if ( !is_alive ) {
+                        close_( fd );
+                    }
+                }
+            }
+        }
+        auto operator=( const password_server& ) -> password_server& = delete;
+        auto operator=( password_server&& ) -> password_server&      = delete;
+        password_server( const std::string_view path )
+          : path_{ path }
+          , listener_{ ::socket( AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0 ) }
+          , epoll_{ -1 }
+          , pool_{}
+          , engine_{ pool_ }
+        {
+            const auto address{ details::make_unix_socket_address( path ) };
+            struct stat status;
+            if ( !listener_.is_valid() || !address.has_value() ) {
+                return;
+            }
+            if ( ::lstat( path_.c_str(), &status ) == 0 && S_ISSOCK( status.st_mode ) ) {
+                const details::file_descriptor probe{ ::socket( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0 ) };
+                if ( !probe.is_valid()
+                     || ::connect( probe.get(), reinterpret_cast< const sockaddr* >( &*address ), sizeof( *address ) ) == 0 )
+                {
+                    path_.clear();
+                    return;
+                }
+                ::unlink( path_.c_str() );
+            }
+            if ( ::bind( listener_.get(), reinterpret_cast< const sockaddr* >( &*address ), sizeof( *address ) ) != 0 ) {
+                path_.clear();
+                return;
+            }
+            if ( ::listen( listener_.get(), SOMAXCONN ) != 0 ) {
+                return;
+            }
+            if ( !pool_.is_ready() ) {
+                return;
+            }
+            symbols_.reserve( character_class::all );
+            for ( unsigned classes{ 1 }; classes <= character_class::all; ++classes ) {
+                auto& symbols{ symbols_.emplace_back( *make_password_sampler( classes ) ) };
+                char warm_up;
+                symbols.read( std::span{ &warm_up, 1 }, engine_ );
+            }
+            epoll_.reset( ::epoll_create1( EPOLL_CLOEXEC ) );
+            if ( epoll_.is_valid() && !watch_( listener_.get(), EPOLLIN, EPOLL_CTL_ADD ) ) {
+                epoll_.reset( -1 );
+            }
+        }
+        password_server( const password_server& ) = delete;
+        password_server( password_server&& )      = delete;
+        ~password_server() noexcept
+        {
+            for ( const auto& [ fd, connection ] : connections_ ) {
+                ::close( fd );
+            }
+            if ( !path_.empty() && listener_.is_valid() ) {
+                ::unlink( path_.c_str() );
+            }
+        }
+    };
+    inline auto request_passwords( const std::string_view path, const password_request& request, output_buffer& buffer )
+      -> std::optional< password_response_status >
+    {
+        const auto address{ details::make_unix_socket_address( path ) };
+        const details::file_descriptor fd{ ::socket( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0 ) };
+        if ( !address.has_value() || !fd.is_valid()
+             || ::connect( fd.get(), reinterpret_cast< const sockaddr* >( &*address ), sizeof( *address ) ) != 0
+             || !details::send_all( fd.get(), std::as_bytes( std::span{ &request, 1 } ) ) )
+        {
+            return std::nullopt;
+        }
+        password_response_header header;
+        if ( !details::receive_all( fd.get(), std::as_writable_bytes( std::span{ &header, 1 } ) ) ) {
+            return std::nullopt;
+        }
+        for ( std::size_t remaining{ header.size }; remaining > 0; ) {
+            const auto block{ buffer.acquire( std::ranges::min( remaining, buffer.capacity() ) ) };
+            if ( !details::receive_all( fd.get(), std::as_writable_bytes( block ) ) ) {
+                return std::nullopt;
+            }
+            buffer.commit( block.size() );
+            remaining -= block.size();
+        }
+        buffer.flush();
+        return header.status;
+    }
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,270 @@
+#pragma once
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+# include <immintrin.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string_view>
+#include "cpu.hpp"
+namespace cpp_utils
+{
+    struct password_score final
+    {
+        std::array< std::uint32_t, 5 > class_counts{};
+        std::uint32_t repeated_characters{ 0 };
+        std::uint32_t sequential_characters{ 0 };
+        std::uint32_t dictionary_characters{ 0 };
+        double entropy_bits{ 0 };
+    };
+    namespace details
+    {
+        inline constexpr std::array< std::string_view, 154 > common_words{
+          "abc", "abcd", "abcdef", "abcdefg", "access", "admin", "administrator", "andrew", "angel",
+          "angels", "apple", "arsenal", "asdf", "asdfgh", "asdfghjkl", "ashley", "autumn", "baby",
+          "babygirl", "banana", "baseball", "basketball", "batman", "bear", "beijing", "boy", "brother",
+          "buster", "changeme", "charlie", "cheese", "chelsea", "china", "computer", "cookie", "cowboys",
+          "dallas", "daniel", "database", "default", "diamond", "dolphin", "dragon", "dream", "eagle",
+          "facebook", "falcon", "family", "father", "flower", "flowers", "football", "fortnite", "freedom",
+          "friend", "friends", "gamer", "george", "ginger", "girl", "golden", "google", "guest", "hacker",
+          "harley", "hello", "hellokitty", "hockey", "hottie", "hunter", "iloveyou", "internet", "jennifer",
+          "jessica", "jordan", "joshua", "killer", "lemon", "letmein", "lion", "liverpool", "login",
+          "london", "love", "lovely", "loveme", "lover", "magic", "manager", "master", "matrix", "matthew",
+          "michael", "michelle", "minecraft", "monkey", "mother", "mustang", "mysql", "naruto", "ninja",
+          "office", "oracle", "orange", "passpass", "password", "pepper", "phoenix", "player", "pokemon",
+          "princess", "qazwsx", "qweasd", "qwerty", "qwertyuiop", "ranger", "robert", "root", "samurai",
+          "secret", "server", "service", "sexy", "shadow", "shanghai", "silver", "sister", "soccer",
+          "spring", "starwars", "summer", "sunshine", "superman", "system", "test", "tester", "testing",
+          "thomas", "tiger", "toor", "trustno", "twitter", "user", "warrior", "welcome", "whatever",
+          "winter", "wolf", "yahoo", "yankees", "youtube", "zaq", "zxcvbn", "zxcvbnm" };
+        inline constexpr std::size_t max_common_word_size{ std::ranges::max(
+          common_words, {}, []( const std::string_view word ) noexcept { return word.size(); } ).size() };
+        inline constexpr auto to_lower_letter( const char c ) noexcept
+        {
+            return c >= 'A' && c <= 'Z' ? static_cast< char >( c - 'A' + 'a' ) : c;
+        }
+        inline constexpr auto letter_codes{ [] consteval
+        {
+            std::array< std::uint8_t, 256 > result{};
+            for ( char c{ 'a' }; c <= 'z'; ++c ) {
+                result[ static_cast< unsigned char >( c ) ]             = static_cast< std::uint8_t >( c - 'a' + 1 );
+                result[ static_cast< unsigned char >( c - 'a' + 'A' ) ] = static_cast< std::uint8_t >( c - 'a' + 1 );
+            }
+            return result;
+        }() };
+        inline constexpr auto word_prefix_index( const char* const prefix ) noexcept
+        {
+            return ( static_cast< std::size_t >( letter_codes[ static_cast< unsigned char >( prefix[ 0 ] ) ] ) << 10 )
+                 | ( static_cast< std::size_t >( letter_codes[ static_cast< unsigned char >( prefix[ 1 ] ) ] ) << 5 )
+                 | static_cast< std::size_t >( letter_codes[ static_cast< unsigned char >( prefix[ 2 ] ) ] );
+        }
+        inline constexpr auto common_word_prefixes{ [] consteval
+        {
+            std::array< std::uint64_t, ( 1uz << 15 ) / 64 > bitmap{};
+            for ( const auto word : common_words ) {
+                const auto index{ word_prefix_index( word.data() ) };
+                bitmap[ index / 64 ] |= 1ull << ( index % 64 );
+            }
+            return bitmap;
+        }() };
+        inline constexpr std::array< double, 32 > class_set_bits{ [] consteval
+        {
+            constexpr std::array< double, 5 > class_sizes{ 26, 26, 10, 33, 128 };
+            std::array< double, 32 > result{};
+            for ( std::size_t classes{ 1 }; classes < result.size(); ++classes ) {
+                double size{ 0 };
+                for ( std::size_t i{ 0 }; i < class_sizes.size(); ++i ) {
+                    size += classes & ( 1uz << i ) ? class_sizes[ i ] : 0;
+                }
+                result[ classes ] = std::log2( size );
+            }
+            return result;
+        }() };
+        using class_histogram_kernel_t = void ( * )( std::string_view, std::array< std::uint32_t, 5 >& ) noexcept;
+        inline auto class_histogram_scalar( const std::string_view password, std::array< std::uint32_t, 5 >& counts ) noexcept
+        {
+            for ( const auto c : password ) {
+                if ( c >= 'A' && c <= 'Z' ) {
+                    ++counts[ 0 ];
+                } else if ( c >= 'a' && c <= 'z' ) {
+                    ++counts[ 1 ];
+                } else if ( c >= '0' && c <= '9' ) {
+                    ++counts[ 2 ];
+                } else if ( c >= ' ' && c <= '~' ) {
+                    ++counts[ 3 ];
+                } else {
+                    ++counts[ 4 ];
+                }
+            }
+        }
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+        [[gnu::target( "avx2" )]]
+        inline auto bytes_in_range_avx2( const __m256i bytes, const char first, const char last ) noexcept
+        {
+            return static_cast< unsigned >( _mm256_movemask_epi8( _mm256_and_si256(
+              _mm256_cmpgt_epi8( bytes, _mm256_set1_epi8( static_cast< char >( first - 1 ) ) ),
+              _mm256_cmpgt_epi8( _mm256_set1_epi8( static_cast< char >( last + 1 ) ), bytes ) ) ) );
+        }
+        [[gnu::target( "avx2" )]]
+        inline auto class_histogram_avx2( const std::string_view password, std::array< std::uint32_t, 5 >& counts ) noexcept
+        {
+            for ( std::size_t offset{ 0 }; offset < password.size(); offset += 32 ) {
+                const auto size{ std::ranges::min( password.size() - offset, 32uz ) };
+                __m256i bytes;
+                if ( size == 32 ) {
+                    bytes = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( password.data() + offset ) );
+                } else {
+                    alignas( 32 ) std::array< char, 32 > tail{};
+                    std::memcpy( tail.data(), password.data() + offset, size );
+                    bytes = _mm256_load_si256( reinterpret_cast< const __m256i* >( tail.data() ) );
+                }
+                const auto valid{ size == 32 ? ~0u : ( 1u << size ) - 1 };
+                const auto capital{ bytes_in_range_avx2( bytes, 'A', 'Z' ) & valid };
+                const auto lowercase{ bytes_in_range_avx2( bytes, 'a', 'z' ) & valid };
+                const auto number{ bytes_in_range_avx2( bytes, '0', '9' ) & valid };
+                const auto printable{ bytes_in_range_avx2( bytes, ' ', '~' ) & valid };
+                counts[ 0 ] += static_cast< std::uint32_t >( std::popcount( capital ) );
+                counts[ 1 ] += static_cast< std::uint32_t >( std::popcount( lowercase ) );
+                counts[ 2 ] += static_cast< std::uint32_t >( std::popcount( number ) );
+                counts[ 3 ] += static_cast< std::uint32_t >( std::popcount( printable & ~( capital | lowercase | number ) ) );
+                counts[ 4 ] += static_cast< std::uint32_t >( std::popcount( valid & ~printable ) );
+            }
+        }
+#endif
+        inline auto select_class_histogram_kernel() noexcept -> class_histogram_kernel_t
+        {
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+            if ( get_cpu_features().avx2 ) {
+                return class_histogram_avx2;
+            }
+#endif
+            return class_histogram_scalar;
+        }
+        inline auto match_common_words( const std::string_view password, const std::size_t position ) noexcept
+        {
+            std::uint32_t sizes{ 0 };
+            if ( password.size() - position < 3 ) {
+                return sizes;
+            }
+            const auto index{ word_prefix_index( password.data() + position ) };
+            if ( !( common_word_prefixes[ index / 64 ] & ( 1ull << ( index % 64 ) ) ) ) {
+                return sizes;
+            }
+            const std::array prefix{
+              to_lower_letter( password[ position ] ), to_lower_letter( password[ position + 1 ] ),
+              to_lower_letter( password[ position + 2 ] ) };
+            const auto candidates{ std::ranges::equal_range(
+              common_words, std::string_view{ prefix.data(), prefix.size() }, {},
+              []( const std::string_view word ) noexcept { return word.substr( 0, 3 ); } ) };
+            for ( const auto word : candidates ) {
+                if ( word.size() <= password.size() - position
+                     && std::ranges::equal( word, password.substr( position, word.size() ), {}, {}, to_lower_letter ) )
+                {
+                    sizes |= 1u << word.size();
+                }
+            }
+            return sizes;
+        }
+    }
+    inline auto score_password( const std::string_view password ) noexcept
+    {
+        static const auto class_histogram{ details::select_class_histogram_kernel() };
+        static const auto common_word_bits{ std::log2( static_cast< double >( details::common_words.size() ) ) };
+        constexpr auto window_size{ std::bit_ceil( details::max_common_word_size + 1 ) };
+        constexpr auto unreachable{ std::numeric_limits< double >::infinity() };
+        password_score score;
+        class_histogram( password, score.class_counts );
+        std::size_t classes{ 0 };
+        for ( std::size_t i{ 0 }; i < score.class_counts.size(); ++i ) {
+            classes |= score.class_counts[ i ] != 0 ? 1uz << i : 0uz;
+        }
+        const auto character_bits{ details::class_set_bits[ classes ] };
+        const auto is_predictable{ [ & ]( const std::size_t i ) noexcept
+        {
+            const auto is_repeated{ i >= 1 && password[ i ] == password[ i - 1 ] };
+            const auto step{ i >= 2 ? password[ i ] - password[ i - 1 ] : 0 };
+            const auto is_sequential{
+              !is_repeated && ( step == 1 || step == -1 ) && step == password[ i - 1 ] - password[ i - 2 ] };
+            return std::pair{ is_repeated, is_sequential };
+        } };
+        std::size_t prefix_index{ 0 };
+        auto has_common_word_prefix{ false };
+        for ( std::size_t i{ 0 }; i < password.size(); ++i ) {
+            prefix_index = ( ( prefix_index << 5 ) | details::letter_codes[ static_cast< unsigned char >( password[ i ] ) ] )
+                         & ( ( 1uz << 15 ) - 1 );
+            has_common_word_prefix
+              |= i >= 2 && ( ( details::common_word_prefixes[ prefix_index / 64 ] >> ( prefix_index % 64 ) ) & 1 ) != 0;
+            const auto [ is_repeated, is_sequential ]{ is_predictable( i ) };
+            score.repeated_characters += is_repeated ? 1 : 0;
+            score.sequential_characters += is_sequential ? 1 : 0;
+        }
+        const auto num_of_predictable_characters{ score.repeated_characters + score.sequential_characters };
+        if ( !has_common_word_prefix ) {
+            score.entropy_bits = static_cast< double >( password.size() - num_of_predictable_characters ) * character_bits
+                               + static_cast< double >( num_of_predictable_characters );
+            return score;
+        }
+        std::array< double, window_size > bits;
+        std::array< std::uint32_t, window_size > dictionary_sizes{};
+        bits.fill( unreachable );
+        bits[ 0 ] = 0;
+        const auto relax{ [ & ]( const std::size_t target, const double target_bits, const std::uint32_t target_size ) noexcept
+        {
+            if ( target_bits < bits[ target % window_size ] ) {
+                bits[ target % window_size ]             = target_bits;
+                dictionary_sizes[ target % window_size ] = target_size;
+            }
+        } };
+        for ( std::size_t i{ 0 }; i < password.size(); ++i ) {
+            const auto current_bits{ bits[ i % window_size ] };
+            const auto current_size{ dictionary_sizes[ i % window_size ] };
+            bits[ i % window_size ] = unreachable;
+            const auto [ is_repeated, is_sequential ]{ is_predictable( i ) };
+            relax( i + 1, current_bits + ( is_repeated || is_sequential ? 1.0 : character_bits ), current_size );
+            for ( auto sizes{ details::match_common_words( password, i ) }; sizes != 0; sizes &= sizes - 1 ) {
+                const auto size{ static_cast< std::size_t >( std::countr_zero( sizes ) ) };
+                relax( i + size, current_bits + common_word_bits, current_size + static_cast< std::uint32_t >( size ) );
+            }
+        }
+        score.dictionary_characters = dictionary_sizes[ password.size() % window_size ];
+        score.entropy_bits          = bits[ password.size() % window_size ];
+        return score;
+    }
+    inline auto score_passwords(
+      const std::span< const std::string_view > passwords, const std::span< password_score > scores ) noexcept
+    {
+        for ( std::size_t i{ 0 }; i < passwords.size(); ++i ) {
+            scores[ i ] = score_password( passwords[ i ] );
+        }
+    }
+    inline auto password_score_field_size( const std::size_t max_password_size ) noexcept
+    {
+        std::array< char, 32 > text;
+        const auto max_bits{ static_cast< double >( max_password_size ) * 8.0 };
+        const auto end{ std::to_chars( text.data(), text.data() + text.size(), max_bits, std::chars_format::fixed, 1 ).ptr };
+        return static_cast< std::size_t >( end - text.data() ) + 1;
+    }
+    inline auto write_password_score_bits( const std::span< char > out, const password_score& score ) noexcept
+    {
+        const auto end{
+          std::to_chars( out.data(), out.data() + out.size(), score.entropy_bits, std::chars_format::fixed, 1 ).ptr };
+        return static_cast< std::size_t >( end - out.data() );
+    }
+    inline auto write_password_score( const std::span< char > field, const password_score& score ) noexcept
+    {
+        std::ranges::fill( field, ' ' );
+        field.front() = '\t';
+        std::array< char, 32 > text;
+        const auto end{
+          std::to_chars( text.data(), text.data() + text.size(), score.entropy_bits, std::chars_format::fixed, 1 ).ptr };
+        const auto size{ static_cast< std::size_t >( end - text.data() ) };
+        std::ranges::copy( text.data(), end, field.data() + field.size() - size );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,1024 @@
+#pragma once
+#if defined( __linux__ )
+# include <pthread.h>
+# include <sys/random.h>
+# include <cerrno>
+# include <csignal>
+#endif
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+# include <immintrin.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <print>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "compiler.hpp"
+#include "const_string.hpp"
+#include "cpu.hpp"
+namespace cpp_utils
+{
+    inline auto secure_zero( const std::span< std::byte > buffer ) noexcept
+    {
+        const auto data{ static_cast< volatile std::byte* >( buffer.data() ) };
+        for ( std::size_t i{ 0 }; i < buffer.size(); ++i ) {
+            data[ i ] = std::byte{ 0 };
+        }
+    }
+    inline auto fill_with_entropy( std::span< std::byte > buffer ) noexcept
+    {
+#if defined( __linux__ )
+        while ( !buffer.empty() ) {
+            const auto result{ getrandom( buffer.data(), buffer.size(), 0 ) };
+            if ( result < 0 ) {
+                if ( errno == EINTR ) {
+                    continue;
+                }
+                return false;
+            }
+            buffer = buffer.subspan( static_cast< std::size_t >( result ) );
+        }
+        return true;
+#else
+        std::random_device device;
+        while ( !buffer.empty() ) {
+            const auto word{ device() };
+            const auto size{ std::ranges::min( buffer.size(), sizeof( word ) ) };
+            std::memcpy( buffer.data(), &word, size );
+            buffer = buffer.subspan( size );
+        }
+        return true;
+#endif
+    }
+    namespace details
+    {
+        inline constexpr std::size_t chacha20_block_size{ 64 };
+        using chacha20_kernel_t = void ( * )( const std::uint32_t*, std::uint64_t, std::byte*, std::size_t ) noexcept;
+        inline constexpr auto chacha20_quarter_round(
+          std::uint32_t& a, std::uint32_t& b, std::uint32_t& c, std::uint32_t& d ) noexcept
+        {
+            a += b;
+            d = std::rotl( d ^ a, 16 );
+            c += d;
+            b = std::rotl( b ^ c, 12 );
+            a += b;
+            d = std::rotl( d ^ a, 8 );
+            c += d;
+            b = std::rotl( b ^ c, 7 );
+        }
+        inline auto chacha20_blocks_scalar(
+          const std::uint32_t* const input, std::uint64_t counter, std::byte* out, const std::size_t blocks ) noexcept
+        {
+            for ( std::size_t i{ 0 }; i < blocks; ++i, ++counter, out += chacha20_block_size ) {
+                std::array< std::uint32_t, 16 > state;
+                std::copy_n( input, 16, state.begin() );
+                state[ 12 ] = static_cast< std::uint32_t >( counter );
+                state[ 13 ] = static_cast< std::uint32_t >( counter >> 32 );
+                auto x{ state };
+                for ( int round{ 0 }; round < 10; ++round ) {
+                    chacha20_quarter_round( x[ 0 ], x[ 4 ], x[ 8 ], x[ 12 ] );
+                    chacha20_quarter_round( x[ 1 ], x[ 5 ], x[ 9 ], x[ 13 ] );
+                    chacha20_quarter_round( x[ 2 ], x[ 6 ], x[ 10 ], x[ 14 ] );
+                    chacha20_quarter_round( x[ 3 ], x[ 7 ], x[ 11 ], x[ 15 ] );
+                    chacha20_quarter_round( x[ 0 ], x[ 5 ], x[ 10 ], x[ 15 ] );
+                    chacha20_quarter_round( x[ 1 ], x[ 6 ], x[ 11 ], x[ 12 ] );
+                    chacha20_quarter_round( x[ 2 ], x[ 7 ], x[ 8 ], x[ 13 ] );
+                    chacha20_quarter_round( x[ 3 ], x[ 4 ], x[ 9 ], x[ 14 ] );
+                }
+                for ( std::size_t j{ 0 }; j < 16; ++j ) {
+                    const auto word{ x[ j ] + state[ j ] };
+                    std::memcpy( out + j * sizeof( word ), &word, sizeof( word ) );
+                }
+            }
+        }
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+        [[gnu::target( "avx2" )]] inline auto chacha20_rotl_avx2( const __m256i v, const int n ) noexcept
+        {
+            return _mm256_or_si256( _mm256_slli_epi32( v, n ), _mm256_srli_epi32( v, 32 - n ) );
+        }
+        [[gnu::target( "avx2" )]] inline auto chacha20_quarter_round_avx2(
+          __m256i& a, __m256i& b, __m256i& c, __m256i& d ) noexcept
+        {
+            const auto rot16{ _mm256_setr_epi8(
+              2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13 ) };
+            const auto rot8{ _mm256_setr_epi8(
+              3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14, 3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14 ) };
+            a = _mm256_add_epi32( a, b );
+            d = _mm256_shuffle_epi8( _mm256_xor_si256( d, a ), rot16 );
+            c = _mm256_add_epi32( c, d );
+            b = chacha20_rotl_avx2( _mm256_xor_si256( b, c ), 12 );
+            a = _mm256_add_epi32( a, b );
+            d = _mm256_shuffle_epi8( _mm256_xor_si256( d, a ), rot8 );
+            c = _mm256_add_epi32( c, d );
+            b = chacha20_rotl_avx2( _mm256_xor_si256( b, c ), 7 );
+        }
+        [[gnu::target( "avx2" )]] inline auto chacha20_transpose_avx2( __m256i* const v ) noexcept
+        {
+            const auto t0{ _mm256_unpacklo_epi32( v[ 0 ], v[ 1 ] ) };
+            const auto t1{ _mm256_unpackhi_epi32( v[ 0 ], v[ 1 ] ) };
+            const auto t2{ _mm256_unpacklo_epi32( v[ 2 ], v[ 3 ] ) };
+            const auto t3{ _mm256_unpackhi_epi32( v[ 2 ], v[ 3 ] ) };
+            const auto t4{ _mm256_unpacklo_epi32( v[ 4 ], v[ 5 ] ) };
+            const auto t5{ _mm256_unpackhi_epi32( v[ 4 ], v[ 5 ] ) };
+            const auto t6{ _mm256_unpacklo_epi32( v[ 6 ], v[ 7 ] ) };
+            const auto t7{ _mm256_unpackhi_epi32( v[ 6 ], v[ 7 ] ) };
+            const auto u0{ _mm256_unpacklo_epi64( t0, t2 ) };
+            const auto u1{ _mm256_unpackhi_epi64( t0, t2 ) };
+            const auto u2{ _mm256_unpacklo_epi64( t1, t3 ) };
+            const auto u3{ _mm256_unpackhi_epi64( t1, t3 ) };
+            const auto u4{ _mm256_unpacklo_epi64( t4, t6 ) };
+            const auto u5{ _mm256_unpackhi_epi64( t4, t6 ) };
+            const auto u6{ _mm256_unpacklo_epi64( t5, t7 ) };
+            const auto u7{ _mm256_unpackhi_epi64( t5, t7 ) };
+            v[ 0 ] = _mm256_permute2x128_si256( u0, u4, 0x20 );
+            v[ 1 ] = _mm256_permute2x128_si256( u1, u5, 0x20 );
+            v[ 2 ] = _mm256_permute2x128_si256( u2, u6, 0x20 );
+            v[ 3 ] = _mm256_permute2x128_si256( u3, u7, 0x20 );
+            v[ 4 ] = _mm256_permute2x128_si256( u0, u4, 0x31 );
+            v[ 5 ] = _mm256_permute2x128_si256( u1, u5, 0x31 );
+            v[ 6 ] = _mm256_permute2x128_si256( u2, u6, 0x31 );
+            v[ 7 ] = _mm256_permute2x128_si256( u3, u7, 0x31 );
+        }
+        [[gnu::target( "avx2" )]] inline auto chacha20_blocks_avx2(
+          const std::uint32_t* const input, std::uint64_t counter, std::byte* out, std::size_t blocks ) noexcept
+        {
+            for ( ; blocks >= 8; blocks -= 8, counter += 8, out += 8 * chacha20_block_size ) {
+                const auto lanes{ _mm256_setr_epi64x( 0, 1, 2, 3 ) };
+                const auto base{ _mm256_set1_epi64x( static_cast< long long >( counter ) ) };
+                const auto lo_counters{ _mm256_add_epi64( base, lanes ) };
+                const auto hi_counters{ _mm256_add_epi64( base, _mm256_add_epi64( lanes, _mm256_set1_epi64x( 4 ) ) ) };
+                const auto gather_lo{ _mm256_setr_epi32( 0, 2, 4, 6, 0, 2, 4, 6 ) };
+                const auto gather_hi{ _mm256_setr_epi32( 1, 3, 5, 7, 1, 3, 5, 7 ) };
+                const auto counter_lo{ _mm256_blend_epi32(
+                  _mm256_permutevar8x32_epi32( lo_counters, gather_lo ), _mm256_permutevar8x32_epi32( hi_counters, gather_lo ),
+                  0xf0 ) };
+                const auto counter_hi{ _mm256_blend_epi32(
+                  _mm256_permutevar8x32_epi32( lo_counters, gather_hi ), _mm256_permutevar8x32_epi32( hi_counters, gather_hi ),
+                  0xf0 ) };
+                __m256i state[ 16 ];
+                for ( std::size_t i{ 0 }; i < 16; ++i ) {
+                    state[ i ] = _mm256_set1_epi32( static_cast< int >( input[ i ] ) );
+                }
+                state[ 12 ] = counter_lo;
+                state[ 13 ] = counter_hi;
+                __m256i x[ 16 ];
+                std::copy_n( state, 16, x );
+                for ( int round{ 0 }; round < 10; ++round ) {
+                    chacha20_quarter_round_avx2( x[ 0 ], x[ 4 ], x[ 8 ], x[ 12 ] );
+                    chacha20_quarter_round_avx2( x[ 1 ], x[ 5 ], x[ 9 ], x[ 13 ] );
+                    chacha20_quarter_round_avx2( x[ 2 ], x[ 6 ], x[ 10 ], x[ 14 ] );
+                    chacha20_quarter_round_avx2( x[ 3 ], x[ 7 ], x[ 11 ], x[ 15 ] );
+                    chacha20_quarter_round_avx2( x[ 0 ], x[ 5 ], x[ 10 ], x[ 15 ] );
+                    chacha20_quarter_round_avx2( x[ 1 ], x[ 6 ], x[ 11 ], x[ 12 ] );
+                    chacha20_quarter_round_avx2( x[ 2 ], x[ 7 ], x[ 8 ], x[ 13 ] );
+                    chacha20_quarter_round_avx2( x[ 3 ], x[ 4 ], x[ 9 ], x[ 14 ] );
+                }
+                for ( std::size_t i{ 0 }; i < 16; ++i ) {
+                    x[ i ] = _mm256_add_epi32( x[ i ], state[ i ] );
+                }
+                chacha20_transpose_avx2( x );
+                chacha20_transpose_avx2( x + 8 );
+                for ( std::size_t i{ 0 }; i < 8; ++i ) {
+                    const auto block{ reinterpret_cast< __m256i* >( out + i * chacha20_block_size ) };
+                    _mm256_storeu_si256( block, x[ i ] );
+                    _mm256_storeu_si256( block + 1, x[ i + 8 ] );
+                }
+            }
+            chacha20_blocks_scalar( input, counter, out, blocks );
+        }
+        [[gnu::target( "avx512f" )]] inline auto chacha20_quarter_round_avx512(
+          __m512i& a, __m512i& b, __m512i& c, __m512i& d ) noexcept
+        {
+            a = _mm512_add_epi32( a, b );
+            d = _mm512_rol_epi32( _mm512_xor_si512( d, a ), 16 );
+            c = _mm512_add_epi32( c, d );
+            b = _mm512_rol_epi32( _mm512_xor_si512( b, c ), 12 );
+            a = _mm512_add_epi32( a, b );
+            d = _mm512_rol_epi32( _mm512_xor_si512( d, a ), 8 );
+            c = _mm512_add_epi32( c, d );
+            b = _mm512_rol_epi32( _mm512_xor_si512( b, c ), 7 );
+        }
+        [[gnu::target( "avx512f" )]] inline auto chacha20_blocks_avx512(
+          const std::uint32_t* const input, std::uint64_t counter, std::byte* out, std::size_t blocks ) noexcept
+        {
+            for ( ; blocks >= 16; blocks -= 16, counter += 16, out += 16 * chacha20_block_size ) {
+                const auto base{ _mm512_set1_epi64( static_cast< long long >( counter ) ) };
+                const auto lo_counters{ _mm512_add_epi64( base, _mm512_setr_epi64( 0, 1, 2, 3, 4, 5, 6, 7 ) ) };
+                const auto hi_counters{ _mm512_add_epi64( base, _mm512_setr_epi64( 8, 9, 10, 11, 12, 13, 14, 15 ) ) };
+                const auto gather_lo{ _mm512_setr_epi32( 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30 ) };
+                const auto gather_hi{ _mm512_setr_epi32( 1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31 ) };
+                __m512i state[ 16 ];
+                for ( std::size_t i{ 0 }; i < 16; ++i ) {
+                    state[ i ] = _mm512_set1_epi32( static_cast< int >( input[ i ] ) );
+                }
+                state[ 12 ] = _mm512_permutex2var_epi32( lo_counters, gather_lo, hi_counters );
+                state[ 13 ] = _mm512_permutex2var_epi32( lo_counters, gather_hi, hi_counters );
+                __m512i x[ 16 ];
+                std::copy_n( state, 16, x );
+                for ( int round{ 0 }; round < 10; ++round ) {
+                    chacha20_quarter_round_avx512( x[ 0 ], x[ 4 ], x[ 8 ], x[ 12 ] );
+                    chacha20_quarter_round_avx512( x[ 1 ], x[ 5 ], x[ 9 ], x[ 13 ] );
+                    chacha20_quarter_round_avx512( x[ 2 ], x[ 6 ], x[ 10 ], x[ 14 ] );
+                    chacha20_quarter_round_avx512( x[ 3 ], x[ 7 ], x[ 11 ], x[ 15 ] );
+                    chacha20_quarter_round_avx512( x[ 0 ], x[ 5 ], x[ 10 ], x[ 15 ] );
+                    chacha20_quarter_round_avx512( x[ 1 ], x[ 6 ], x[ 11 ], x[ 12 ] );
+                    chacha20_quarter_round_avx512( x[ 2 ], x[ 7 ], x[ 8 ], x[ 13 ] );
+                    chacha20_quarter_round_avx512( x[ 3 ], x[ 4 ], x[ 9 ], x[ 14 ] );
+                }
+                __m512i u[ 16 ];
+                for ( std::size_t i{ 0 }; i < 16; i += 4 ) {
+                    const auto a{ _mm512_add_epi32( x[ i ], state[ i ] ) };
+                    const auto b{ _mm512_add_epi32( x[ i + 1 ], state[ i + 1 ] ) };
+                    const auto c{ _mm512_add_epi32( x[ i + 2 ], state[ i + 2 ] ) };
+                    const auto d{ _mm512_add_epi32( x[ i + 3 ], state[ i + 3 ] ) };
+                    const auto ab_lo{ _mm512_unpacklo_epi32( a, b ) };
+                    const auto ab_hi{ _mm512_unpackhi_epi32( a, b ) };
+                    const auto cd_lo{ _mm512_unpacklo_epi32( c, d ) };
+                    const auto cd_hi{ _mm512_unpackhi_epi32( c, d ) };
+                    u[ i ]     = _mm512_unpacklo_epi64( ab_lo, cd_lo );
+                    u[ i + 1 ] = _mm512_unpackhi_epi64( ab_lo, cd_lo );
+                    u[ i + 2 ] = _mm512_unpacklo_epi64( ab_hi, cd_hi );
+                    u[ i + 3 ] = _mm512_unpackhi_epi64( ab_hi, cd_hi );
+                }
+                for ( std::size_t k{ 0 }; k < 4; ++k ) {
+                    const auto a{ _mm512_shuffle_i32x4( u[ k ], u[ k + 4 ], 0x44 ) };
+                    const auto b{ _mm512_shuffle_i32x4( u[ k ], u[ k + 4 ], 0xee ) };
+                    const auto c{ _mm512_shuffle_i32x4( u[ k + 8 ], u[ k + 12 ], 0x44 ) };
+                    const auto d{ _mm512_shuffle_i32x4( u[ k + 8 ], u[ k + 12 ], 0xee ) };
+                    _mm512_storeu_si512( out + k * chacha20_block_size, _mm512_shuffle_i32x4( a, c, 0x88 ) );
+                    _mm512_storeu_si512( out + ( k + 4 ) * chacha20_block_size, _mm512_shuffle_i32x4( a, c, 0xdd ) );
+                    _mm512_storeu_si512( out + ( k + 8 ) * chacha20_block_size, _mm512_shuffle_i32x4( b, d, 0x88 ) );
+                    _mm512_storeu_si512( out + ( k + 12 ) * chacha20_block_size, _mm512_shuffle_i32x4( b, d, 0xdd ) );
+                }
+            }
+            chacha20_blocks_avx2( input, counter, out, blocks );
+        }
+#endif
+        inline auto select_chacha20_kernel() noexcept -> chacha20_kernel_t
+        {
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+            const auto& features{ get_cpu_features() };
+            if ( features.avx512f ) {
+                return chacha20_blocks_avx512;
+            }
+            if ( features.avx2 ) {
+                return chacha20_blocks_avx2;
+            }
+#endif
+            return chacha20_blocks_scalar;
+        }
+    }
+    class chacha20_engine final
+    {
+      public:
+        using result_type = std::uint64_t;
+        using key_type    = std::array< std::uint32_t, 8 >;
+        static constexpr auto min() noexcept
+        {
+            return std::numeric_limits< result_type >::min();
+        }
+        static constexpr auto max() noexcept
+        {
+            return std::numeric_limits< result_type >::max();
+        }
+      private:
+        static constexpr std::size_t buffer_blocks_{ 16 };
+        std::array< std::uint32_t, 16 > input_{};
+        std::uint64_t counter_{ 0 };
+        details::chacha20_kernel_t kernel_{ details::select_chacha20_kernel() };
+        std::size_t refill_blocks_{ buffer_blocks_ };
+        std::size_t size_{ 0 };
+        std::size_t position_{ 0 };
+        alignas( 64 ) std::array< std::byte, buffer_blocks_ * details::chacha20_block_size > buffer_{};
+        auto refill_() noexcept
+        {
+            kernel_( input_.data(), counter_, buffer_.data(), refill_blocks_ );
+            counter_ += refill_blocks_;
+            size_          = refill_blocks_ * details::chacha20_block_size;
+            position_      = 0;
+            refill_blocks_ = std::ranges::min( refill_blocks_ * 2, buffer_blocks_ );
+        }
+      public:
+        auto stream() const noexcept
+        {
+            return static_cast< std::uint64_t >( input_[ 14 ] ) | static_cast< std::uint64_t >( input_[ 15 ] ) << 32;
+        }
+        auto seek( const std::uint64_t block_counter ) noexcept
+        {
+            counter_       = block_counter;
+            refill_blocks_ = 1;
+            size_          = 0;
+            position_      = 0;
+        }
+        auto restart( const std::uint64_t stream ) noexcept
+        {
+            input_[ 14 ] = static_cast< std::uint32_t >( stream );
+            input_[ 15 ] = static_cast< std::uint32_t >( stream >> 32 );
+            seek( 0 );
+        }
+        auto fill( std::span< std::byte > out ) noexcept
+        {
+            const auto buffered{ std::ranges::min( out.size(), size_ - position_ ) };
+            std::memcpy( out.data(), buffer_.data() + position_, buffered );
+            position_ += buffered;
+            out = out.subspan( buffered );
+            const auto direct_blocks{ out.size() / details::chacha20_block_size };
+            kernel_( input_.data(), counter_, out.data(), direct_blocks );
+            counter_ += direct_blocks;
+            out = out.subspan( direct_blocks * details::chacha20_block_size );
+            if ( !out.empty() ) {
+                refill_();
+                std::memcpy( out.data(), buffer_.data(), out.size() );
+                position_ = out.size();
+            }
+        }
+        auto operator()() noexcept
+        {
+            if ( size_ - position_ < sizeof( result_type ) ) {
+                refill_();
+            }
+            result_type result;
+            std::memcpy( &result, buffer_.data() + position_, sizeof( result ) );
+            position_ += sizeof( result );
+            return result;
+        }
+        auto operator=( const chacha20_engine& ) -> chacha20_engine& = default;
+        auto operator=( chacha20_engine&& ) -> chacha20_engine&      = default;
+        chacha20_engine( const key_type& key, const std::uint64_t stream = 0 ) noexcept
+        {
+            input_[ 0 ] = 0x61707865;
+            input_[ 1 ] = 0x3320646e;
+            input_[ 2 ] = 0x79622d32;
+            input_[ 3 ] = 0x6b206574;
+            std::ranges::copy( key, input_.begin() + 4 );
+            input_[ 14 ] = static_cast< std::uint32_t >( stream );
+            input_[ 15 ] = static_cast< std::uint32_t >( stream >> 32 );
+        }
+        chacha20_engine( const chacha20_engine& )     = default;
+        chacha20_engine( chacha20_engine&& ) noexcept = default;
+        ~chacha20_engine() noexcept
+        {
+            secure_zero( std::as_writable_bytes( std::span{ input_ } ) );
+            secure_zero( buffer_ );
+        }
+    };
+    inline auto parse_seed( const std::string_view text ) noexcept -> std::optional< chacha20_engine::key_type >
+    {
+        constexpr std::size_t max_digits{ sizeof( chacha20_engine::key_type ) * 2 };
+        if ( text.empty() || text.size() > max_digits ) {
+            return std::nullopt;
+        }
+        std::array< std::uint8_t, sizeof( chacha20_engine::key_type ) > bytes{};
+        const auto padding{ max_digits - text.size() };
+        for ( std::size_t i{ 0 }; i < text.size(); ++i ) {
+            std::uint8_t digit;
+            const auto [ end, error ]{ std::from_chars( text.data() + i, text.data() + i + 1, digit, 16 ) };
+            if ( error != std::errc{} ) {
+                return std::nullopt;
+            }
+            const auto position{ padding + i };
+            bytes[ position / 2 ] |= static_cast< std::uint8_t >( position % 2 == 0 ? digit << 4 : digit );
+        }
+        chacha20_engine::key_type key;
+        for ( std::size_t i{ 0 }; i < key.size(); ++i ) {
+            key[ i ] = static_cast< std::uint32_t >( bytes[ i * 4 ] ) | static_cast< std::uint32_t >( bytes[ i * 4 + 1 ] ) << 8
+                     | static_cast< std::uint32_t >( bytes[ i * 4 + 2 ] ) << 16
+                     | static_cast< std::uint32_t >( bytes[ i * 4 + 3 ] ) << 24;
+        }
+        return key;
+    }
+    template < typename Engine >
+    concept uniform_64_bit_engine = std::uniform_random_bit_generator< Engine > && Engine::min() == 0
+                                 && Engine::max() == std::numeric_limits< std::uint64_t >::max();
+    static_assert(
+      uniform_64_bit_engine< std::mt19937_64 > && !uniform_64_bit_engine< std::mt19937 >
+      && !uniform_64_bit_engine< std::minstd_rand > && !uniform_64_bit_engine< std::ranlux24 > );
+    template < uniform_64_bit_engine Engine >
+    inline auto fill_random_bytes( Engine& engine, std::span< std::byte > out ) noexcept
+    {
+        if constexpr ( requires { engine.fill( out ); } ) {
+            engine.fill( out );
+        } else {
+            using result_t = typename Engine::result_type;
+            while ( !out.empty() ) {
+                const auto word{ static_cast< result_t >( engine() ) };
+                const auto size{ std::ranges::min( out.size(), sizeof( word ) ) };
+                std::memcpy( out.data(), &word, size );
+                out = out.subspan( size );
+            }
+        }
+    }
+    struct entropy_pool_statistics final
+    {
+        std::size_t capacity;
+        std::size_t fill_level;
+        std::uint64_t refilled_blocks;
+        std::uint64_t consumed_blocks;
+        std::uint64_t empty_waits;
+        double refill_seconds;
+    };
+    class entropy_pool final
+    {
+      public:
+        static constexpr std::size_t block_size{ 4096 };
+      private:
+        struct alignas( 64 ) slot_ final
+        {
+            std::atomic< std::size_t > sequence{ 0 };
+        };
+        std::size_t capacity_;
+        std::size_t low_water_mark_;
+        std::unique_ptr< slot_[] > slots_;
+        std::unique_ptr< std::byte[] > blocks_;
+        std::optional< chacha20_engine > engine_{};
+        alignas( 64 ) std::atomic< std::size_t > head_{ 0 };
+        alignas( 64 ) std::atomic< std::size_t > tail_{ 0 };
+        alignas( 64 ) std::atomic< std::uint32_t > refill_signal_{ 0 };
+        std::atomic< bool > is_stopping_{ false };
+        std::atomic< std::uint64_t > refilled_blocks_{ 0 };
+        std::atomic< std::uint64_t > consumed_blocks_{ 0 };
+        std::atomic< std::uint64_t > empty_waits_{ 0 };
+        std::atomic< std::uint64_t > refill_nanoseconds_{ 0 };
+        std::thread refill_thread_{};
+        auto block_( const std::size_t position ) const noexcept
+        {
+            return std::span< std::byte >{ blocks_.get() + ( position & ( capacity_ - 1 ) ) * block_size, block_size };
+        }
+        auto wake_refill_thread_() noexcept
+        {
+            refill_signal_.fetch_add( 1, std::memory_order_release );
+            refill_signal_.notify_one();
+        }
+        auto refill_() noexcept
+        {
+            while ( !is_stopping_.load( std::memory_order_relaxed ) ) {
+                const auto start_time{ std::chrono::steady_clock::now() };
+                std::uint64_t num_of_blocks{ 0 };
+                for ( auto tail{ tail_.load( std::memory_order_relaxed ) };
+                      tail - head_.load( std::memory_order_acquire ) < capacity_; ++tail, ++num_of_blocks )
+                {
+                    auto& slot{ slots_[ tail & ( capacity_ - 1 ) ] };
+                    while ( slot.sequence.load( std::memory_order_acquire ) != tail ) {
+                        std::this_thread::yield();
+                    }
+                    fill_random_bytes( *engine_, block_( tail ) );
+                    slot.sequence.store( tail + 1, std::memory_order_release );
+                    tail_.store( tail + 1, std::memory_order_release );
+                    tail_.notify_all();
+                }
+                refilled_blocks_.fetch_add( num_of_blocks, std::memory_order_relaxed );
+                refill_nanoseconds_.fetch_add(
+                  static_cast< std::uint64_t >(
+                    std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - start_time )
+                      .count() ),
+                  std::memory_order_relaxed );
+                const auto signal{ refill_signal_.load( std::memory_order_acquire ) };
+                if ( !is_stopping_.load( std::memory_order_relaxed ) && fill_level() > low_water_mark_ ) {
+                    refill_signal_.wait( signal, std::memory_order_acquire );
+                }
+            }
+        }
+        auto try_take_( const std::span< std::byte > out ) noexcept
+        {
+            auto position{ head_.load( std::memory_order_relaxed ) };
+            while ( true ) {
+                const auto sequence{ slots_[ position & ( capacity_ - 1 ) ].sequence.load( std::memory_order_acquire ) };
+                if ( sequence == position + 1 ) {
+                    if ( head_.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) ) {
+                        break;
+                    }
+                } else if ( sequence < position + 1 ) {
+                    return false;
+                } else {
+                    position = head_.load( std::memory_order_relaxed );
+                }
+            }
+            const auto block{ block_( position ) };
+            std::memcpy( out.data(), block.data(), block_size );
+            secure_zero( block );
+            slots_[ position & ( capacity_ - 1 ) ].sequence.store( position + capacity_, std::memory_order_release );
+            consumed_blocks_.fetch_add( 1, std::memory_order_relaxed );
+            if ( tail_.load( std::memory_order_relaxed ) - ( position + 1 ) <= low_water_mark_ ) {
+                wake_refill_thread_();
+            }
+            return true;
+        }
+      public:
+        auto is_ready() const noexcept
+        {
+            return refill_thread_.joinable();
+        }
+        auto capacity() const noexcept
+        {
+            return capacity_;
+        }
+        auto fill_level() const noexcept -> std::size_t
+        {
+            const auto head{ head_.load( std::memory_order_relaxed ) };
+            const auto tail{ tail_.load( std::memory_order_relaxed ) };
+            return tail > head ? tail - head : 0;
+        }
+        auto statistics() const noexcept
+        {
+            return entropy_pool_statistics{
+              capacity_,
+              fill_level(),
+              refilled_blocks_.load( std::memory_order_relaxed ),
+              consumed_blocks_.load( std::memory_order_relaxed ),
+              empty_waits_.load( std::memory_order_relaxed ),
+              static_cast< double >( refill_nanoseconds_.load( std::memory_order_relaxed ) ) / 1e9 };
+        }
+        auto take( const std::span< std::byte > out ) noexcept
+        {
+            if ( out.size() != block_size || !is_ready() ) {
+                if constexpr ( is_debugging_build ) {
+                    std::print( "'out' must hold exactly one block of a ready entropy pool!\n" );
+                    std::terminate();
+                } else {
+                    std::unreachable();
+                }
+            }
+            while ( !try_take_( out ) ) {
+                empty_waits_.fetch_add( 1, std::memory_order_relaxed );
+                const auto tail{ tail_.load( std::memory_order_acquire ) };
+                wake_refill_thread_();
+                if ( tail == head_.load( std::memory_order_acquire ) ) {
+                    tail_.wait( tail, std::memory_order_acquire );
+                }
+            }
+        }
+        auto operator=( const entropy_pool& ) -> entropy_pool& = delete;
+        auto operator=( entropy_pool&& ) -> entropy_pool&      = delete;
+        entropy_pool( const std::size_t capacity = 64, const std::size_t low_water_mark = 16 )
+          : capacity_{ std::bit_ceil( std::ranges::max( capacity, 2uz ) ) }
+          , low_water_mark_{ std::ranges::min( low_water_mark, capacity_ - 1 ) }
+          , slots_{ std::make_unique< slot_[] >( capacity_ ) }
+          , blocks_{ std::make_unique< std::byte[] >( capacity_ * block_size ) }
+        {
+            for ( std::size_t i{ 0 }; i < capacity_; ++i ) {
+                slots_[ i ].sequence.store( i, std::memory_order_relaxed );
+            }
+            chacha20_engine::key_type key;
+            if ( !fill_with_entropy( std::as_writable_bytes( std::span{ key } ) ) ) {
+                return;
+            }
+            engine_.emplace( key );
+            secure_zero( std::as_writable_bytes( std::span{ key } ) );
+            refill_thread_ = std::thread{ [ this ] noexcept
+            {
+#if defined( __linux__ )
+                sigset_t signals;
+                ::sigfillset( &signals );
+                ::pthread_sigmask( SIG_BLOCK, &signals, nullptr );
+#endif
+                refill_();
+            } };
+        }
+        entropy_pool( const entropy_pool& ) = delete;
+        entropy_pool( entropy_pool&& )      = delete;
+        ~entropy_pool() noexcept
+        {
+            if ( refill_thread_.joinable() ) {
+                is_stopping_.store( true, std::memory_order_relaxed );
+                wake_refill_thread_();
+                refill_thread_.join();
+            }
+            secure_zero( std::span{ blocks_.get(), capacity_ * block_size } );
+        }
+    };
+    class entropy_pool_engine final
+    {
+      public:
+        using result_type = std::uint64_t;
+        static constexpr auto min() noexcept
+        {
+            return std::numeric_limits< result_type >::min();
+        }
+        static constexpr auto max() noexcept
+        {
+            return std::numeric_limits< result_type >::max();
+        }
+      private:
+        entropy_pool* pool_;
+        std::size_t position_{ entropy_pool::block_size };
+        alignas( 64 ) std::array< std::byte, entropy_pool::block_size > buffer_{};
+      public:
+        auto fill( std::span< std::byte > out ) noexcept
+        {
+            const auto buffered{ std::ranges::min( out.size(), buffer_.size() - position_ ) };
+            std::memcpy( out.data(), buffer_.data() + position_, buffered );
+            secure_zero( std::span{ buffer_.data() + position_, buffered } );
+            position_ += buffered;
+            out = out.subspan( buffered );
+            for ( ; out.size() >= entropy_pool::block_size; out = out.subspan( entropy_pool::block_size ) ) {
+                pool_->take( out.first( entropy_pool::block_size ) );
+            }
+            if ( !out.empty() ) {
+                pool_->take( buffer_ );
+                std::memcpy( out.data(), buffer_.data(), out.size() );
+                secure_zero( std::span{ buffer_.data(), out.size() } );
+                position_ = out.size();
+            }
+        }
+        auto operator()() noexcept
+        {
+            result_type result;
+            fill( std::as_writable_bytes( std::span{ &result, 1 } ) );
+            return result;
+        }
+        auto operator=( const entropy_pool_engine& ) -> entropy_pool_engine& = delete;
+        auto operator=( entropy_pool_engine&& ) -> entropy_pool_engine&      = default;
+        entropy_pool_engine( entropy_pool& pool ) noexcept
+          : pool_{ &pool }
+        { }
+        entropy_pool_engine( const entropy_pool_engine& )     = delete;
+        entropy_pool_engine( entropy_pool_engine&& ) noexcept = default;
+        ~entropy_pool_engine() noexcept
+        {
+            secure_zero( buffer_ );
+        }
+    };
+    template < std::unsigned_integral Word >
+        requires( sizeof( Word ) <= sizeof( std::uint32_t ) )
+    class uniform_index_sampler final
+    {
+      private:
+        using wide_t = std::conditional_t< sizeof( Word ) < sizeof( std::uint32_t ), std::uint32_t, std::uint64_t >;
+        static constexpr auto word_bits_{ std::numeric_limits< Word >::digits };
+        Word bound_;
+        Word threshold_;
+        bool is_power_of_two_;
+      public:
+        constexpr auto bound() const noexcept
+        {
+            return bound_;
+        }
+        constexpr auto reduce( const Word word ) const noexcept
+        {
+            if ( is_power_of_two_ ) {
+                return std::pair{ static_cast< Word >( word & ( bound_ - 1 ) ), true };
+            }
+            const auto product{ static_cast< wide_t >( word ) * bound_ };
+            return std::pair{ static_cast< Word >( product >> word_bits_ ), static_cast< Word >( product ) >= threshold_ };
+        }
+        constexpr auto sample( const std::span< const Word > words, Word* const out ) const noexcept
+        {
+            std::size_t produced{ 0 };
+            if ( is_power_of_two_ ) {
+                const auto mask{ static_cast< Word >( bound_ - 1 ) };
+                for ( const auto word : words ) {
+                    out[ produced++ ] = word & mask;
+                }
+                return produced;
+            }
+            for ( const auto word : words ) {
+                const auto product{ static_cast< wide_t >( word ) * bound_ };
+                out[ produced ] = static_cast< Word >( product >> word_bits_ );
+                produced += static_cast< Word >( product ) >= threshold_ ? 1 : 0;
+            }
+            return produced;
+        }
+        constexpr uniform_index_sampler( const Word bound ) noexcept
+          : bound_{ bound }
+          , threshold_{ static_cast< Word >( static_cast< Word >( -bound ) % bound ) }
+          , is_power_of_two_{ std::has_single_bit( bound ) }
+        { }
+    };
+    class alias_table final
+    {
+      private:
+        static constexpr std::uint64_t coin_limit_{ 1ull << 32 };
+        std::vector< std::uint64_t > thresholds_{};
+        std::vector< std::uint32_t > aliases_{};
+        uniform_index_sampler< std::uint32_t > index_sampler_;
+      public:
+        auto size() const noexcept
+        {
+            return aliases_.size();
+        }
+        template < uniform_64_bit_engine Engine >
+        auto operator()( Engine& engine ) const noexcept -> std::size_t
+        {
+            while ( true ) {
+                const auto word{ static_cast< std::uint64_t >( engine() ) };
+                const auto [ index, accepted ]{ index_sampler_.reduce( static_cast< std::uint32_t >( word ) ) };
+                if ( accepted ) {
+                    return ( word >> 32 ) < thresholds_[ index ] ? index : aliases_[ index ];
+                }
+            }
+        }
+        alias_table( const std::span< const double > weights ) noexcept
+          : thresholds_( weights.size() )
+          , aliases_( weights.size() )
+          , index_sampler_{ static_cast< std::uint32_t >( weights.size() ) }
+        {
+            const auto size{ weights.size() };
+            const auto total{ std::accumulate( weights.begin(), weights.end(), 0.0 ) };
+            std::vector< double > scaled( size );
+            std::vector< std::uint32_t > small;
+            std::vector< std::uint32_t > large;
+            for ( std::size_t i{ 0 }; i < size; ++i ) {
+                scaled[ i ] = weights[ i ] * static_cast< double >( size ) / total;
+                ( scaled[ i ] < 1.0 ? small : large ).emplace_back( static_cast< std::uint32_t >( i ) );
+            }
+            while ( !small.empty() && !large.empty() ) {
+                const auto less{ small.back() };
+                const auto more{ large.back() };
+                small.pop_back();
+                thresholds_[ less ] = static_cast< std::uint64_t >( scaled[ less ] * static_cast< double >( coin_limit_ ) );
+                aliases_[ less ]    = more;
+                scaled[ more ] -= 1.0 - scaled[ less ];
+                if ( scaled[ more ] < 1.0 ) {
+                    large.pop_back();
+                    small.emplace_back( more );
+                }
+            }
+            for ( const auto index : large ) {
+                thresholds_[ index ] = coin_limit_;
+                aliases_[ index ]    = index;
+            }
+            for ( const auto index : small ) {
+                thresholds_[ index ] = coin_limit_;
+                aliases_[ index ]    = index;
+            }
+        }
+    };
+    namespace details
+    {
+        inline constexpr std::size_t max_symbols{ 128 };
+        struct symbol_table final
+        {
+            alignas( 64 ) std::array< char, max_symbols > symbols;
+            std::uint8_t size;
+            std::uint8_t mask;
+        };
+        using symbol_kernel_t = std::size_t ( * )( const symbol_table&, const std::byte*, std::size_t, char* ) noexcept;
+        template < std::size_t Size >
+        inline auto symbol_count( const symbol_table& table ) noexcept
+        {
+            if constexpr ( Size == 0 ) {
+                return static_cast< std::size_t >( table.size );
+            } else {
+                return Size;
+            }
+        }
+        template < std::size_t Size >
+        inline auto symbol_mask( const symbol_table& table ) noexcept
+        {
+            if constexpr ( Size == 0 ) {
+                return table.mask;
+            } else {
+                return static_cast< std::uint8_t >( std::bit_ceil( Size ) - 1 );
+            }
+        }
+        template < std::size_t Size >
+        inline auto sample_masked_symbols_scalar(
+          const symbol_table& table, const std::byte* const bytes, const std::size_t size, char* const out ) noexcept
+        {
+            const auto count{ symbol_count< Size >( table ) };
+            const auto mask{ symbol_mask< Size >( table ) };
+            std::size_t produced{ 0 };
+            for ( std::size_t i{ 0 }; i < size; ++i ) {
+                const auto index{ static_cast< std::size_t >( std::to_integer< std::uint8_t >( bytes[ i ] ) & mask ) };
+                out[ produced ] = table.symbols[ index ];
+                produced += index < count ? 1 : 0;
+            }
+            return produced;
+        }
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+        inline constexpr auto compress_shuffle_table{ [] consteval
+        {
+            std::array< std::array< std::uint8_t, 8 >, 256 > result{};
+            for ( std::size_t mask{ 0 }; mask < result.size(); ++mask ) {
+                std::size_t count{ 0 };
+                for ( std::uint8_t bit{ 0 }; bit < 8; ++bit ) {
+                    if ( ( mask >> bit ) & 1 ) {
+                        result[ mask ][ count++ ] = bit;
+                    }
+                }
+                for ( ; count < 8; ++count ) {
+                    result[ mask ][ count ] = 0x80;
+                }
+            }
+            return result;
+        }() };
+        template < std::size_t Size >
+        [[gnu::target( "avx2,popcnt" )]] inline auto sample_symbols_avx2(
+          const symbol_table& table, const std::byte* const bytes, const std::size_t size, char* const out ) noexcept
+        {
+            const auto count{ symbol_count< Size >( table ) };
+            const auto mask{ _mm256_set1_epi8( static_cast< char >( symbol_mask< Size >( table ) ) ) };
+            const auto last{ _mm256_set1_epi8( static_cast< char >( count - 1 ) ) };
+            const auto low_nibble{ _mm256_set1_epi8( 0x0f ) };
+            const auto chunks{ ( count + 15 ) / 16 };
+            __m256i lookups[ max_symbols / 16 ];
+            for ( std::size_t k{ 0 }; k < chunks; ++k ) {
+                lookups[ k ] = _mm256_broadcastsi128_si256(
+                  _mm_load_si128( reinterpret_cast< const __m128i* >( table.symbols.data() + k * 16 ) ) );
+            }
+            std::size_t produced{ 0 };
+            std::size_t i{ 0 };
+            for ( ; i + 32 <= size; i += 32 ) {
+                const auto indices{
+                  _mm256_and_si256( _mm256_loadu_si256( reinterpret_cast< const __m256i* >( bytes + i ) ), mask ) };
+                const auto high{ _mm256_and_si256( _mm256_srli_epi16( indices, 4 ), low_nibble ) };
+                auto symbols{ _mm256_setzero_si256() };
+                for ( std::size_t k{ 0 }; k < chunks; ++k ) {
+                    const auto is_selected{ _mm256_cmpeq_epi8( high, _mm256_set1_epi8( static_cast< char >( k ) ) ) };
+                    symbols           = _mm256_or_si256(
+                      symbols, _mm256_and_si256( is_selected, _mm256_shuffle_epi8( lookups[ k ], indices ) ) );
+                }
+                const auto accepted{ static_cast< std::uint32_t >(
+                  _mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_min_epu8( indices, last ), indices ) ) ) };
+                alignas( 32 ) std::array< long long, 4 > groups;
+                _mm256_store_si256( reinterpret_cast< __m256i* >( groups.data() ), symbols );
+                for ( std::size_t g{ 0 }; g < groups.size(); ++g ) {
+                    const auto group_mask{ ( accepted >> ( g * 8 ) ) & 0xff };
+                    const auto packed{ _mm_shuffle_epi8(
+                      _mm_cvtsi64_si128( groups[ g ] ),
+                      _mm_loadl_epi64( reinterpret_cast< const __m128i* >( compress_shuffle_table[ group_mask ].data() ) ) ) };
+                    _mm_storel_epi64( reinterpret_cast< __m128i* >( out + produced ), packed );
+                    produced += static_cast< std::size_t >( std::popcount( group_mask ) );
+                }
+            }
+            return produced + sample_masked_symbols_scalar< Size >( table, bytes + i, size - i, out + produced );
+        }
+        template < std::size_t Size >
+        [[gnu::target( "avx512f,avx512bw,avx512vbmi,avx512vbmi2,popcnt" )]] inline auto sample_symbols_avx512(
+          const symbol_table& table, const std::byte* const bytes, const std::size_t size, char* const out ) noexcept
+        {
+            const auto lookup_lo{ _mm512_load_si512( table.symbols.data() ) };
+            const auto lookup_hi{ _mm512_load_si512( table.symbols.data() + 64 ) };
+            const auto mask{ _mm512_set1_epi8( static_cast< char >( symbol_mask< Size >( table ) ) ) };
+            const auto bound{ _mm512_set1_epi8( static_cast< char >( symbol_count< Size >( table ) ) ) };
+            std::size_t produced{ 0 };
+            std::size_t i{ 0 };
+            for ( ; i + 64 <= size; i += 64 ) {
+                const auto indices{ _mm512_and_si512( _mm512_loadu_si512( bytes + i ), mask ) };
+                const auto accepted{ _mm512_cmplt_epu8_mask( indices, bound ) };
+                const auto symbols{ _mm512_permutex2var_epi8( lookup_lo, indices, lookup_hi ) };
+                _mm512_storeu_si512( out + produced, _mm512_maskz_compress_epi8( accepted, symbols ) );
+                produced += static_cast< std::size_t >( std::popcount( accepted ) );
+            }
+            return produced + sample_masked_symbols_scalar< Size >( table, bytes + i, size - i, out + produced );
+        }
+#endif
+        template < std::size_t Size >
+        inline auto select_symbol_kernel() noexcept -> symbol_kernel_t
+        {
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+            const auto& features{ get_cpu_features() };
+            if ( features.avx512bw && features.avx512vbmi && features.avx512vbmi2 ) {
+                return sample_symbols_avx512< Size >;
+            }
+            if ( features.avx2 ) {
+                return sample_symbols_avx2< Size >;
+            }
+#endif
+            return sample_masked_symbols_scalar< Size >;
+        }
+    }
+    class symbol_sampler final
+    {
+      private:
+        details::symbol_table table_;
+        details::symbol_kernel_t kernel_;
+        symbol_sampler( const std::span< const char > symbols, const details::symbol_kernel_t kernel ) noexcept
+          : table_{
+              .symbols = {},
+              .size    = static_cast< std::uint8_t >( symbols.size() ),
+              .mask    = static_cast< std::uint8_t >( std::bit_ceil( symbols.size() ) - 1 ) }
+          , kernel_{ kernel }
+        {
+            if ( symbols.empty() || symbols.size() > details::max_symbols ) {
+                if constexpr ( is_debugging_build ) {
+                    std::print( "'symbols' must hold 1 to {} characters!\n", details::max_symbols );
+                    std::terminate();
+                } else {
+                    std::unreachable();
+                }
+            }
+            std::ranges::copy( symbols, table_.symbols.begin() );
+            std::ranges::fill( table_.symbols | std::views::drop( symbols.size() ), symbols.front() );
+        }
+      public:
+        auto size() const noexcept
+        {
+            return static_cast< std::size_t >( table_.size );
+        }
+        auto symbols() const noexcept
+        {
+            return std::string_view{ table_.symbols.data(), size() };
+        }
+        auto sample( const std::span< const std::byte > bytes, char* const out ) const noexcept
+        {
+            return kernel_( table_, bytes.data(), bytes.size(), out );
+        }
+        symbol_sampler( const std::span< const char > symbols ) noexcept
+          : symbol_sampler{ symbols, details::select_symbol_kernel< 0 >() }
+        { }
+        template < std::size_t N >
+            requires( N > 0 && N <= details::max_symbols )
+        symbol_sampler( const basic_const_string< char, N >& symbols ) noexcept
+          : symbol_sampler{ std::span{ symbols.c_str(), N }, details::select_symbol_kernel< N >() }
+        { }
+    };
+    class symbol_buffer final
+    {
+      private:
+        static constexpr std::size_t capacity_{ 4096 };
+        symbol_sampler sampler_;
+        std::size_t refill_size_{ capacity_ };
+        std::size_t position_{ 0 };
+        std::size_t size_{ 0 };
+        alignas( 64 ) std::array< std::byte, capacity_ > bytes_{};
+        alignas( 64 ) std::array< char, capacity_ > symbols_{};
+        template < uniform_64_bit_engine Engine >
+        auto refill_( Engine& engine ) noexcept
+        {
+            const auto bytes{ std::span{ bytes_ }.first( refill_size_ ) };
+            fill_random_bytes( engine, bytes );
+            size_     = sampler_.sample( bytes, symbols_.data() );
+            position_ = 0;
+        }
+      public:
+        auto reset( const std::size_t refill_size ) noexcept
+        {
+            refill_size_ = std::ranges::clamp( refill_size, 1uz, capacity_ );
+            position_    = 0;
+            size_        = 0;
+        }
+        template < uniform_64_bit_engine Engine >
+        auto read( std::span< char > out, Engine& engine ) noexcept
+        {
+            while ( !out.empty() ) {
+                if ( position_ == size_ ) {
+                    refill_( engine );
+                }
+                const auto size{ std::ranges::min( out.size(), size_ - position_ ) };
+                std::memcpy( out.data(), symbols_.data() + position_, size );
+                position_ += size;
+                out = out.subspan( size );
+            }
+        }
+        auto operator=( const symbol_buffer& ) -> symbol_buffer& = delete;
+        auto operator=( symbol_buffer&& ) -> symbol_buffer&      = default;
+        symbol_buffer( const symbol_sampler& sampler ) noexcept
+          : sampler_{ sampler }
+        { }
+        symbol_buffer( const symbol_buffer& )     = delete;
+        symbol_buffer( symbol_buffer&& ) noexcept = default;
+        ~symbol_buffer() noexcept
+        {
+            secure_zero( bytes_ );
+            secure_zero( std::as_writable_bytes( std::span{ symbols_ } ) );
+        }
+    };
+    template < uniform_64_bit_engine Engine >
+    class symbol_stream final
+    {
+      private:
+        Engine engine_;
+        symbol_buffer buffer_;
+      public:
+        auto& engine() noexcept
+        {
+            return engine_;
+        }
+        auto read( const std::span< char > out ) noexcept
+        {
+            buffer_.read( out, engine_ );
+        }
+        auto reset( const std::size_t refill_size ) noexcept
+        {
+            buffer_.reset( refill_size );
+        }
+        auto operator=( const symbol_stream< Engine >& ) -> symbol_stream< Engine >& = delete;
+        auto operator=( symbol_stream< Engine >&& ) -> symbol_stream< Engine >&      = default;
+        symbol_stream( Engine engine, const symbol_sampler& sampler ) noexcept
+          : engine_{ std::move( engine ) }
+          , buffer_{ sampler }
+        { }
+        symbol_stream( const symbol_stream< Engine >& )     = delete;
+        symbol_stream( symbol_stream< Engine >&& ) noexcept = default;
+        ~symbol_stream() noexcept                           = default;
+    };
+}
\ No newline at end of file
@@ -1,21 +1,21 @@
-#include <numeric>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <print>
-#include <random>
-#include <ranges>
 #include <string>
 #include <string_view>
 #include <unordered_map>
-#include <vector>
-auto make_password( const std::size_t length, const std::vector< char >& dic )
-{
-    std::string password( length, '\0' );
-    std::mt19937_64 rng{ std::random_device{}() };
-    std::uniform_int_distribution< std::size_t > dist( 0, dic.size() - 1 );
-    for ( auto& e : password ) {
-        e = dic[ dist( rng ) ];
-    }
-    return password;
-}
+#include <unordered_set>
+#include <utility>
+#include "cpp_utils/password.hpp"
+#include "cpp_utils/password_service.hpp"
 auto show_help_info() noexcept
 {
     std::print(
@@ -27,7 +27,43 @@ auto show_help_info() noexcept
       "  '--no-special-characters': Remove special characters from the dictionary.\n"
       "  '--password-length=[a positive integer]': Set the length of a single password.\n"
       "  '--number-of-passwords=[a positive integer]': Set the number of passwords to generate.\n"
-      "NOTE: The dictionary cannot be empty!\n" );
+      "  '--threads=[a positive integer]': Set the number of threads used to generate passwords.\n"
+      "  '--rng=[mt19937_64|chacha20|pool]': Set the random number generator, 'chacha20' is a CSPRNG seeded by the OS.\n"
+      "      ('pool' draws ChaCha20 blocks that a background thread keeps generated ahead of time)\n"
+      "  '--require-each-class': Include at least one character from every class in the dictionary.\n"
+      "  '--min-capital-letters=[a non-negative integer]': Set the minimum number of capital letters.\n"
+      "  '--min-lowercase-letters=[a non-negative integer]': Set the minimum number of lowercase letters.\n"
+      "  '--min-numbers=[a non-negative integer]': Set the minimum number of numbers.\n"
+      "  '--min-special-characters=[a non-negative integer]': Set the minimum number of special characters.\n"
+      "  '--wordlist=[a file path]': Generate passphrases from a UTF-8 wordlist with one word per line.\n"
+      "      (a line may also be 'word<TAB>weight' to make the word more or less likely to be picked)\n"
+      "  '--words=[a positive integer]': Set the number of words in a passphrase.\n"
+      "  '--separator=[a string]': Set the string placed between the words of a passphrase.\n"
+      "  '--unique': Reject duplicated passwords while generating them.\n"
+      "  '--score': Append the estimated entropy in bits to every generated password.\n"
+      "  '--score-stdin': Read passwords line by line from the standard input stream and print their estimated entropy.\n"
+      "  '--pattern=[a pattern]': Generate passwords that follow a pattern, one character per position.\n"
+      "      (U: capital letter, l: lowercase letter, L: letter, D or 9: number, S: special character,\n"
+      "       C/c: capital/lowercase consonant, V/v: capital/lowercase vowel, A: any character in the dictionary,\n"
+      "       '\\' makes the next character literal, and any other character is copied as is;\n"
+      "       the classes removed by '--no-*' cannot be used)\n"
+      "  '--format=[lines|ndjson|csv|fixed]': Set the output format of the generated passwords.\n"
+      "      ('fixed' writes a length byte and the password padded with zeros to a multiple of 16 bytes per record)\n"
+      "  '--serve=[a socket path]': Stay resident and serve passwords to clients over a Unix domain socket.\n"
+      "  '--connect=[a socket path]': Request passwords from a running server instead of generating them.\n"
+      "      (only the length, the number of passwords and the dictionary options are sent to the server)\n"
+      "  '--emit-hash=[sha256|blake3]': Write the digest of every password next to it.\n"
+      "      (as hexadecimal digits in a text format, or as 32 raw bytes after the padded password in 'fixed')\n"
+      "  '--seed=[up to 64 hex digits]': Generate a reproducible sequence from a ChaCha20 key instead of the OS entropy.\n"
+      "      (every password is derived from the key and its index only, so the output does not depend on '--threads')\n"
+      "  '--shard=[i/n]': Generate only the i-th of n contiguous shards of the sequence selected by '--seed=', from 0.\n"
+      "      (only shard 0 writes the CSV header, so the shards can be concatenated in order)\n"
+      "  '--deny-filter=[a file path]': Regenerate every password whose SHA-256 digest is in a binary fuse filter.\n"
+      "      (the filter is memory-mapped and about 1 in 256 passwords that are not in the deny list is also regenerated)\n"
+      "  '--build-deny-filter=[a file path]': Build a binary fuse filter from the deny list read from the standard input.\n"
+      "      (one password or 64-digit hexadecimal SHA-256 digest per line, with anything after a ':' ignored)\n"
+      "  '--stats': Print the generation throughput to the standard error stream.\n"
+      "NOTE: The dictionary cannot be empty, and the minimums cannot exceed the password length!\n" );
 }
 auto main( const int argc, const char* const args[] ) -> int
 {
@@ -36,12 +72,38 @@ auto main( const int argc, const char* const args[] ) -> int
       {"--no-capital-letters",    false},
       {"--no-lowercase-letters",  false},
       {"--no-numbers",            false},
-      {"--no-special-characters", false}
+      {"--no-special-characters", false},
+      {"--require-each-class",    false},
+      {"--unique",                false},
+      {"--score",                 false},
+      {"--score-stdin",           false},
+      {"--stats",                 false}
     };
     std::unordered_map< std::string_view, long long > settings{
-      {"--password-length=",     16},
-      {"--number-of-passwords=", 1 }
+      {"--password-length=",        16},
+      {"--number-of-passwords=",    1 },
+      {"--threads=",                1 },
+      {"--min-capital-letters=",    0 },
+      {"--min-lowercase-letters=",  0 },
+      {"--min-numbers=",            0 },
+      {"--min-special-characters=", 0 },
+      {"--words=",                  6 }
+    };
+    std::unordered_map< std::string_view, std::string_view > text_settings{
+      {"--rng=",               "mt19937_64"},
+      {"--wordlist=",          ""          },
+      {"--separator=",         " "         },
+      {"--format=",            "lines"     },
+      {"--pattern=",           ""          },
+      {"--serve=",             ""          },
+      {"--connect=",           ""          },
+      {"--seed=",              ""          },
+      {"--shard=",             ""          },
+      {"--emit-hash=",         ""          },
+      {"--deny-filter=",       ""          },
+      {"--build-deny-filter=", ""          }
     };
+    std::unordered_set< std::string_view > given_settings;
     for ( int i{ 1 }; i < argc; ++i ) {
         const std::string_view current_args{ args[ i ] };
         if ( current_args == "--help" ) {
@@ -55,41 +117,352 @@ auto main( const int argc, const char* const args[] ) -> int
         const std::string_view settings_name{ current_args.begin(), std::ranges::find( current_args, '=' ) + 1 };
         if ( settings.contains( settings_name ) ) {
             settings[ settings_name ] = std::stoll( std::ranges::find( current_args, '=' ) + 1 );
+            given_settings.emplace( settings_name );
+            continue;
+        }
+        if ( text_settings.contains( settings_name ) ) {
+            text_settings[ settings_name ] = current_args.substr( settings_name.size() );
+            given_settings.emplace( settings_name );
             continue;
         }
         std::print( error_info );
         return EXIT_FAILURE;
     }
-    std::vector< char > dic;
-    if ( !options[ "--no-capital-letters" ] ) {
-        for ( const auto c : std::ranges::iota_view{ 'A', 'Z' + 1 } ) {
-            dic.emplace_back( c );
+    if ( options[ "--score-stdin" ] ) {
+        cpp_utils::output_buffer buffer{ stdout, cpp_utils::default_output_buffer_size };
+        cpp_utils::score_password_lines( stdin, buffer );
+        if ( !buffer.finish() ) {
+            std::print( stderr, "Failed to write to the standard output stream.\n" );
+            return EXIT_FAILURE;
         }
+        return EXIT_SUCCESS;
     }
-    if ( !options[ "--no-lowercase-letters" ] ) {
-        for ( const auto c : std::ranges::iota_view{ 'a', 'z' + 1 } ) {
-            dic.emplace_back( c );
+    if ( const auto filter_path{ text_settings[ "--build-deny-filter=" ] }; !filter_path.empty() ) {
+        auto keys{ cpp_utils::read_deny_list_keys( stdin ) };
+        const auto filter_data{ cpp_utils::build_binary_fuse_filter( keys ) };
+        const std::string file_path{ filter_path };
+        const auto file{ filter_data.has_value() ? std::fopen( file_path.c_str(), "wb" ) : nullptr };
+        if ( file == nullptr ) {
+            std::print( "Failed to build the deny filter.\n" );
+            return EXIT_FAILURE;
         }
-    }
-    if ( !options[ "--no-numbers" ] ) {
-        for ( const auto c : std::ranges::iota_view{ '1', '9' + 1 } ) {
-            dic.emplace_back( c );
+        const auto is_written{ std::fwrite( filter_data->data(), 1, filter_data->size(), file ) == filter_data->size() };
+        if ( std::fclose( file ) != 0 || !is_written ) {
+            std::print( "Failed to build the deny filter.\n" );
+            return EXIT_FAILURE;
         }
+        std::print( stderr, "Built a deny filter of {} keys in {} bytes.\n", keys.size(), filter_data->size() );
+        return EXIT_SUCCESS;
     }
-    if ( !options[ "--no-special-characters" ] ) {
-        for ( const auto c : R"(!"#$%&'()*+,-./:;<=>?@[\]^_`{|})" ) {
-            dic.emplace_back( c );
+    const auto serve_path{ text_settings[ "--serve=" ] };
+    const auto connect_path{ text_settings[ "--connect=" ] };
+    if ( !serve_path.empty() ) {
+#if defined( __linux__ )
+        cpp_utils::password_server server{ serve_path };
+        if ( !server.is_listening() || !server.run() ) {
+            std::print( "Failed to serve passwords on the socket.\n" );
+            return EXIT_FAILURE;
         }
-        dic.pop_back();
+        return EXIT_SUCCESS;
+#else
+        std::print( "'--serve=' is only supported on Linux.\n" );
+        return EXIT_FAILURE;
+#endif
     }
+    auto classes{ cpp_utils::character_class::all };
+    if ( options[ "--no-capital-letters" ] ) {
+        classes &= ~cpp_utils::character_class::capital_letters;
+    }
+    if ( options[ "--no-lowercase-letters" ] ) {
+        classes &= ~cpp_utils::character_class::lowercase_letters;
+    }
+    if ( options[ "--no-numbers" ] ) {
+        classes &= ~cpp_utils::character_class::numbers;
+    }
+    if ( options[ "--no-special-characters" ] ) {
+        classes &= ~cpp_utils::character_class::special_characters;
+    }
+    const auto sampler{ cpp_utils::make_password_sampler( classes ) };
     const auto password_length{ settings[ "--password-length=" ] };
     const auto num_of_passwords{ settings[ "--number-of-passwords=" ] };
-    if ( num_of_passwords <= 0 || password_length <= 0 || dic.size() == 0 ) {
+    const auto num_of_threads{ settings[ "--threads=" ] };
+    const auto rng_name{ text_settings[ "--rng=" ] };
+    const auto wordlist_path{ text_settings[ "--wordlist=" ] };
+    const auto separator{ text_settings[ "--separator=" ] };
+    const auto num_of_words{ settings[ "--words=" ] };
+    const auto format{ cpp_utils::parse_output_format( text_settings[ "--format=" ] ) };
+    const auto pattern{ text_settings[ "--pattern=" ] };
+    const auto hash_name{ text_settings[ "--emit-hash=" ] };
+    const auto hash{ hash_name.empty() ? std::nullopt : cpp_utils::parse_hash_algorithm( hash_name ) };
+    const std::array minimums{
+      settings[ "--min-capital-letters=" ], settings[ "--min-lowercase-letters=" ], settings[ "--min-numbers=" ],
+      settings[ "--min-special-characters=" ] };
+    if ( num_of_passwords <= 0 || password_length <= 0 || num_of_threads <= 0 || num_of_words <= 0 || !sampler.has_value()
+         || !format.has_value() || ( !hash_name.empty() && !hash.has_value() )
+         || ( rng_name != "mt19937_64" && rng_name != "chacha20" && rng_name != "pool" )
+         || std::ranges::any_of( minimums, []( const long long minimum ) noexcept { return minimum < 0; } ) )
+    {
         std::print( error_info );
         return EXIT_FAILURE;
     }
-    for ( std::remove_const_t< decltype( num_of_passwords ) > _{ 0 }; _ < num_of_passwords; ++_ ) {
-        std::print( "{}\n", make_password( password_length, dic ) );
+    const auto has_minimum_options{
+      options[ "--require-each-class" ]
+      || std::ranges::any_of( minimums, []( const long long minimum ) noexcept { return minimum != 0; } ) };
+    const auto has_length_option{ given_settings.contains( "--password-length=" ) };
+    if ( !pattern.empty() && ( !wordlist_path.empty() || has_length_option || has_minimum_options ) ) {
+        std::print(
+          "'--pattern=' cannot be combined with '--wordlist=', '--password-length=', '--min-*' or '--require-each-class'.\n" );
+        return EXIT_FAILURE;
+    }
+    if ( !wordlist_path.empty()
+         && ( classes != cpp_utils::character_class::all || has_length_option || has_minimum_options ) )
+    {
+        std::print(
+          "'--wordlist=' cannot be combined with '--password-length=', '--no-*', '--min-*' or '--require-each-class'.\n" );
+        return EXIT_FAILURE;
+    }
+    if ( !connect_path.empty() ) {
+#if defined( __linux__ )
+        if ( password_length > static_cast< long long >( cpp_utils::max_served_password_length )
+             || num_of_passwords > std::numeric_limits< std::uint16_t >::max() )
+        {
+            std::print( error_info );
+            return EXIT_FAILURE;
+        }
+        cpp_utils::password_request request;
+        request.length  = static_cast< std::uint16_t >( password_length );
+        request.count   = static_cast< std::uint16_t >( num_of_passwords );
+        request.classes = static_cast< std::uint8_t >( classes );
+        cpp_utils::output_buffer buffer{ stdout, cpp_utils::default_output_buffer_size };
+        const auto status{ cpp_utils::request_passwords( connect_path, request, buffer ) };
+        if ( !status.has_value() ) {
+            std::print( "Failed to request passwords from the socket.\n" );
+            return EXIT_FAILURE;
+        }
+        if ( *status != cpp_utils::password_response_status::ok ) {
+            std::print( "The server rejected the request.\n" );
+            return EXIT_FAILURE;
+        }
+        if ( !buffer.finish() ) {
+            std::print( stderr, "Failed to write to the standard output stream.\n" );
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+#else
+        std::print( "'--connect=' is only supported on Linux.\n" );
+        return EXIT_FAILURE;
+#endif
+    }
+    const auto seed_text{ text_settings[ "--seed=" ] };
+    const auto shard_text{ text_settings[ "--shard=" ] };
+    const auto seed{ seed_text.empty() ? std::nullopt : cpp_utils::parse_seed( seed_text ) };
+    if ( ( !seed_text.empty() && ( !seed.has_value() || options[ "--unique" ] ) )
+         || ( !shard_text.empty() && seed_text.empty() ) )
+    {
+        std::print( error_info );
+        return EXIT_FAILURE;
+    }
+    std::uint64_t first_index{ 0 };
+    auto is_first_shard{ true };
+    auto num_of_generated_passwords{ static_cast< std::size_t >( num_of_passwords ) };
+    if ( !shard_text.empty() ) {
+        const auto index_text{ shard_text.substr( 0, shard_text.find( '/' ) ) };
+        const auto count_text{ shard_text.substr( std::ranges::min( index_text.size() + 1, shard_text.size() ) ) };
+        std::size_t shard_index{ 0 };
+        std::size_t num_of_shards{ 0 };
+        const auto [ index_end, index_error ]{
+          std::from_chars( index_text.data(), index_text.data() + index_text.size(), shard_index ) };
+        const auto [ count_end, count_error ]{
+          std::from_chars( count_text.data(), count_text.data() + count_text.size(), num_of_shards ) };
+        if ( index_error != std::errc{} || index_end != index_text.data() + index_text.size() || count_error != std::errc{}
+             || count_end != count_text.data() + count_text.size() || shard_index >= num_of_shards )
+        {
+            std::print( error_info );
+            return EXIT_FAILURE;
+        }
+        const auto total{ static_cast< std::size_t >( num_of_passwords ) };
+        const auto remainder{ total % num_of_shards };
+        first_index                = total / num_of_shards * shard_index + std::ranges::min( shard_index, remainder );
+        num_of_generated_passwords = total / num_of_shards + ( shard_index < remainder ? 1 : 0 );
+        is_first_shard             = shard_index == 0;
+    }
+    std::array< std::size_t, 4 > class_minimums;
+    for ( std::size_t i{ 0 }; i < class_minimums.size(); ++i ) {
+        class_minimums[ i ] = static_cast< std::size_t >( minimums[ i ] );
+        if ( options[ "--require-each-class" ] && ( classes & ( 1u << i ) ) ) {
+            class_minimums[ i ] = std::ranges::max( class_minimums[ i ], 1uz );
+        }
+    }
+    cpp_utils::password_rules rules;
+    if ( std::ranges::any_of( class_minimums, []( const std::size_t minimum ) noexcept { return minimum != 0; } ) ) {
+        auto policy{ cpp_utils::make_password_policy( classes, class_minimums, static_cast< std::size_t >( password_length ) ) };
+        if ( !policy.has_value() ) {
+            std::print( error_info );
+            return EXIT_FAILURE;
+        }
+        rules.policy = std::make_shared< const cpp_utils::password_policy >( std::move( *policy ) );
+    }
+    if ( !pattern.empty() ) {
+        auto compiled_pattern{ cpp_utils::make_password_pattern( pattern, classes ) };
+        if ( !compiled_pattern.has_value() ) {
+            std::print( "The pattern is malformed or uses a character class removed by '--no-*'.\n" );
+            return EXIT_FAILURE;
+        }
+        rules.pattern = std::make_shared< const cpp_utils::password_pattern >( std::move( *compiled_pattern ) );
+    }
+    const auto generated_length{
+      rules.pattern != nullptr ? rules.pattern->size() : static_cast< std::size_t >( password_length ) };
+    std::optional< cpp_utils::mapped_file > wordlist_file;
+    std::optional< cpp_utils::wordlist > wordlist;
+    if ( !wordlist_path.empty() ) {
+        wordlist_file.emplace( wordlist_path );
+        if ( wordlist_file->is_open() ) {
+            wordlist = cpp_utils::make_wordlist( wordlist_file->data() );
+        }
+        if ( !wordlist.has_value() ) {
+            std::print( "Failed to load the wordlist.\n" );
+            return EXIT_FAILURE;
+        }
+        if ( *format == cpp_utils::output_format::ndjson && !cpp_utils::is_valid_utf8( separator ) ) {
+            std::print( "The separator must be valid UTF-8 text for '--format=ndjson'.\n" );
+            return EXIT_FAILURE;
+        }
+    }
+    const auto deny_filter_path{ text_settings[ "--deny-filter=" ] };
+    std::optional< cpp_utils::mapped_file > deny_filter_file;
+    std::optional< cpp_utils::binary_fuse_filter > deny_filter;
+    if ( !deny_filter_path.empty() ) {
+        deny_filter_file.emplace( deny_filter_path );
+        if ( deny_filter_file->is_open() ) {
+            deny_filter = cpp_utils::make_binary_fuse_filter( deny_filter_file->data() );
+        }
+        if ( !deny_filter.has_value() ) {
+            std::print( "Failed to load the deny filter.\n" );
+            return EXIT_FAILURE;
+        }
+    }
+    std::optional< cpp_utils::unique_password_set > unique_set;
+    if ( options[ "--unique" ] ) {
+        const auto log_num_of_candidates{
+          wordlist.has_value()
+            ? static_cast< double >( num_of_words ) * std::log( static_cast< double >( wordlist->size() ) )
+          : rules.pattern != nullptr
+            ? rules.pattern->log_num_of_candidates()
+            : static_cast< double >( password_length ) * std::log( static_cast< double >( sampler->size() ) )
+                + ( rules.policy != nullptr ? rules.policy->log_compliant_fraction() : 0.0 ) };
+        if ( std::log( static_cast< double >( num_of_passwords ) * 2.0 ) > log_num_of_candidates ) {
+            std::print( "Too many passwords for '--unique', at most half of all possible passwords can be generated.\n" );
+            return EXIT_FAILURE;
+        }
+        std::uint64_t key;
+        if ( !cpp_utils::fill_with_entropy( std::as_writable_bytes( std::span{ &key, 1 } ) ) ) {
+            std::print( "Failed to collect entropy from the operating system.\n" );
+            return EXIT_FAILURE;
+        }
+        unique_set.emplace( static_cast< std::size_t >( num_of_passwords ), key );
+    }
+    const cpp_utils::password_options generation_options{
+      unique_set.has_value() ? &*unique_set : nullptr, options[ "--score" ], *format,
+      seed.has_value() ? std::optional{ first_index } : std::nullopt, hash,
+      deny_filter.has_value() ? &*deny_filter : nullptr };
+    const auto max_password_size{
+      wordlist.has_value()
+        ? cpp_utils::max_passphrase_size( *wordlist, static_cast< std::size_t >( num_of_words ), separator )
+        : generated_length };
+    if ( !cpp_utils::is_output_format_supported( max_password_size, generation_options ) ) {
+        std::print( "The 'fixed' format only supports passwords of at most 255 bytes without '--score'.\n" );
+        return EXIT_FAILURE;
+    }
+    std::size_t num_of_rejections{ 0 };
+    std::size_t num_of_denials{ 0 };
+    const auto start_time{ std::chrono::steady_clock::now() };
+    cpp_utils::output_buffer buffer{ stdout, cpp_utils::default_output_buffer_size };
+    if ( is_first_shard ) {
+        cpp_utils::write_output_header( buffer, generation_options );
+    }
+    auto is_complete{ false };
+    const auto generate{ [ & ]( auto& workers )
+    {
+        if ( wordlist.has_value() ) {
+            is_complete = cpp_utils::write_passphrases(
+              buffer, workers, num_of_generated_passwords, *wordlist,
+              static_cast< std::size_t >( num_of_words ), separator, generation_options );
+        } else {
+            is_complete = cpp_utils::write_passwords(
+              buffer, workers, num_of_generated_passwords, generated_length,
+              generation_options );
+        }
+        for ( const auto& worker : workers ) {
+            num_of_rejections += worker.num_of_rejections;
+            num_of_denials += worker.num_of_denials;
+        }
+    } };
+    std::optional< cpp_utils::entropy_pool > pool;
+    if ( seed.has_value() ) {
+        auto workers{ cpp_utils::make_seeded_password_workers(
+          static_cast< std::size_t >( num_of_threads ), *sampler, rules, *seed ) };
+        generate( workers );
+    } else if ( rng_name == "pool" ) {
+        pool.emplace(
+          std::ranges::max( 64uz, static_cast< std::size_t >( num_of_threads ) * 16 ),
+          std::ranges::max( 16uz, static_cast< std::size_t >( num_of_threads ) * 4 ) );
+        if ( !pool->is_ready() ) {
+            std::print( "Failed to collect entropy from the operating system.\n" );
+            return EXIT_FAILURE;
+        }
+        auto workers{
+          cpp_utils::make_pool_password_workers( static_cast< std::size_t >( num_of_threads ), *sampler, rules, *pool ) };
+        generate( workers );
+    } else if ( rng_name == "chacha20" ) {
+        auto workers{ cpp_utils::make_chacha20_password_workers(
+          static_cast< std::size_t >( num_of_threads ), *sampler, rules ) };
+        if ( workers.empty() ) {
+            std::print( "Failed to collect entropy from the operating system.\n" );
+            return EXIT_FAILURE;
+        }
+        generate( workers );
+    } else {
+        auto workers{ cpp_utils::make_mt19937_64_password_workers(
+          static_cast< std::size_t >( num_of_threads ), *sampler, rules ) };
+        generate( workers );
+    }
+    if ( !buffer.finish() ) {
+        std::print( stderr, "Failed to write to the standard output stream.\n" );
+        return EXIT_FAILURE;
+    }
+    if ( !is_complete ) {
+        std::print( stderr, "Some passwords were still in the deny filter after too many attempts and were left out.\n" );
+        return EXIT_FAILURE;
+    }
+    if ( options[ "--stats" ] ) {
+        const std::chrono::duration< double > elapsed_time{ std::chrono::steady_clock::now() - start_time };
+        const auto seconds{ std::ranges::max( elapsed_time.count(), 1e-9 ) };
+        std::print(
+          stderr, "Generated {} passwords ({} bytes) in {:.3f} s: {:.0f} passwords/s, {:.2f} MB/s.\n",
+          num_of_generated_passwords, buffer.flushed_size(), seconds,
+          static_cast< double >( num_of_generated_passwords ) / seconds,
+          static_cast< double >( buffer.flushed_size() ) / seconds / 1e6 );
+        if ( unique_set.has_value() ) {
+            std::print(
+              stderr, "Unique set: {:.2f} MiB, {} duplicates rejected ({:.6f}% of generated passwords).\n",
+              static_cast< double >( unique_set->memory_size() ) / ( 1 << 20 ), num_of_rejections,
+              static_cast< double >( num_of_rejections ) * 100.0
+                / static_cast< double >( static_cast< std::size_t >( num_of_passwords ) + num_of_rejections ) );
+        }
+        if ( deny_filter.has_value() ) {
+            std::print(
+              stderr, "Deny filter: {} keys in {:.2f} MiB, {} passwords regenerated.\n", deny_filter->size(),
+              static_cast< double >( deny_filter->memory_size() ) / ( 1 << 20 ), num_of_denials );
+        }
+        if ( pool.has_value() ) {
+            const auto statistics{ pool->statistics() };
+            std::print(
+              stderr, "Entropy pool: {}/{} blocks filled, {} refilled at {:.2f} MB/s, {} consumed, {} empty waits.\n",
+              statistics.fill_level, statistics.capacity, statistics.refilled_blocks,
+              static_cast< double >( statistics.refilled_blocks * cpp_utils::entropy_pool::block_size )
+                / std::ranges::max( statistics.refill_seconds, 1e-9 ) / 1e6,
+              statistics.consumed_blocks, statistics.empty_waits );
+        }
     }
     return EXIT_SUCCESS;
 }
\ No newline at end of file
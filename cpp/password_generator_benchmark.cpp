@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "cpp_utils/password.hpp"
+inline std::atomic< std::size_t > num_of_allocations{ 0 };
+auto operator new( const std::size_t size ) -> void*
+{
+    num_of_allocations.fetch_add( 1, std::memory_order_relaxed );
+    const auto ptr{ std::malloc( std::ranges::max( size, 1uz ) ) };
+    if ( ptr == nullptr ) {
+        std::abort();
+    }
+    return ptr;
+}
+auto operator new( const std::size_t size, const std::align_val_t alignment ) -> void*
+{
+    num_of_allocations.fetch_add( 1, std::memory_order_relaxed );
+    const auto align{ static_cast< std::size_t >( alignment ) };
+    const auto ptr{ std::aligned_alloc( align, ( std::ranges::max( size, 1uz ) + align - 1 ) / align * align ) };
+    if ( ptr == nullptr ) {
+        std::abort();
+    }
+    return ptr;
+}
+auto operator delete( void* const ptr ) noexcept -> void
+{
+    std::free( ptr );
+}
+auto operator delete( void* const ptr, std::size_t ) noexcept -> void
+{
+    std::free( ptr );
+}
+auto operator delete( void* const ptr, std::align_val_t ) noexcept -> void
+{
+    std::free( ptr );
+}
+auto operator delete( void* const ptr, std::size_t, std::align_val_t ) noexcept -> void
+{
+    std::free( ptr );
+}
+struct benchmark_case final
+{
+    std::size_t password_length;
+    std::size_t num_of_passwords;
+    unsigned classes;
+    std::string_view rng_name;
+    std::size_t num_of_threads;
+};
+struct benchmark_result final
+{
+    std::size_t iterations;
+    double setup_ns;
+    double ns_per_password;
+    double bytes_per_second;
+    double allocations_per_password;
+};
+auto parse_list( const std::string_view text, std::vector< std::size_t >& values ) noexcept
+{
+    values.clear();
+    for ( auto rest{ text }; !rest.empty(); ) {
+        const auto item{ rest.substr( 0, rest.find( ',' ) ) };
+        std::size_t value{ 0 };
+        const auto [ end, error ]{ std::from_chars( item.data(), item.data() + item.size(), value ) };
+        if ( error != std::errc{} || end != item.data() + item.size() || value == 0 ) {
+            return false;
+        }
+        values.emplace_back( value );
+        rest.remove_prefix( std::ranges::min( item.size() + 1, rest.size() ) );
+    }
+    return !values.empty();
+}
+auto run_case(
+  const benchmark_case& current, const std::chrono::nanoseconds min_duration, std::FILE* const null_stream )
+  -> std::optional< benchmark_result >
+{
+    const auto setup_start_time{ std::chrono::steady_clock::now() };
+    const auto sampler{ cpp_utils::make_password_sampler( current.classes ) };
+    cpp_utils::output_buffer buffer{ null_stream, cpp_utils::default_output_buffer_size };
+    const auto measure{ [ & ]( auto& workers )
+    {
+        const auto start_time{ std::chrono::steady_clock::now() };
+        const std::chrono::duration< double > setup_time{ start_time - setup_start_time };
+        std::size_t iterations{ 0 };
+        const auto allocations_before{ num_of_allocations.load( std::memory_order_relaxed ) };
+        auto elapsed_time{ std::chrono::steady_clock::duration::zero() };
+        do {
+            cpp_utils::write_passwords( buffer, workers, current.num_of_passwords, current.password_length, {} );
+            ++iterations;
+            elapsed_time = std::chrono::steady_clock::now() - start_time;
+        } while ( elapsed_time < min_duration );
+        const auto allocations{ num_of_allocations.load( std::memory_order_relaxed ) - allocations_before };
+        const auto num_of_passwords{ static_cast< double >( current.num_of_passwords * iterations ) };
+        const auto seconds{ std::ranges::max( std::chrono::duration< double >{ elapsed_time }.count(), 1e-9 ) };
+        return benchmark_result{
+          iterations, setup_time.count() * 1e9, seconds * 1e9 / num_of_passwords,
+          num_of_passwords * static_cast< double >( current.password_length + 1 ) / seconds,
+          static_cast< double >( allocations ) / num_of_passwords };
+    } };
+    if ( current.rng_name == "pool" ) {
+        cpp_utils::entropy_pool pool;
+        if ( !pool.is_ready() ) {
+            return std::nullopt;
+        }
+        auto workers{ cpp_utils::make_pool_password_workers( current.num_of_threads, *sampler, {}, pool ) };
+        return measure( workers );
+    }
+    if ( current.rng_name == "chacha20" ) {
+        auto workers{ cpp_utils::make_chacha20_password_workers( current.num_of_threads, *sampler, {} ) };
+        if ( workers.empty() ) {
+            return std::nullopt;
+        }
+        return measure( workers );
+    }
+    auto workers{ cpp_utils::make_mt19937_64_password_workers( current.num_of_threads, *sampler, {} ) };
+    return measure( workers );
+}
+auto show_help_info() noexcept
+{
+    std::print(
+      "[ Password Generator Benchmark ]\n"
+      "Supported arguments:\n"
+      "  '--password-lengths=[a comma separated list]': Set the password lengths to measure.\n"
+      "  '--numbers-of-passwords=[a comma separated list]': Set the numbers of passwords generated per run.\n"
+      "  '--dictionaries=[a comma separated list]': Set the dictionaries to measure, as bit masks from 1 to 15.\n"
+      "      (1: capital letters, 2: lowercase letters, 4: numbers, 8: special characters)\n"
+      "  '--rngs=[a comma separated list]': Set the random number generators to measure.\n"
+      "  '--threads=[a comma separated list]': Set the numbers of threads to measure.\n"
+      "  '--min-duration-ms=[a positive integer]': Repeat every case until it has run for this long.\n"
+      "      (the workers, the entropy pool and the output buffer are built once per case and reported as 'setup_ns')\n"
+      "  '--output=[a file path]': Write the JSON report to a file instead of the standard output stream.\n"
+      "NOTE: Every combination of the lists above is measured!\n" );
+}
+auto main( const int argc, const char* const args[] ) -> int
+{
+    constexpr auto error_info{ "Arguments failed! Please use '--help' to view the usage guide.\n" };
+    std::unordered_map< std::string_view, std::string_view > settings{
+      {"--password-lengths=",     "8,16,32,64,256,1024,4096"         },
+      {"--numbers-of-passwords=", "1,100,10000,1000000"              },
+      {"--dictionaries=",         "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15"},
+      {"--rngs=",                 "mt19937_64,chacha20"              },
+      {"--threads=",              "1"                                },
+      {"--min-duration-ms=",      "100"                              },
+      {"--output=",               ""                                 }
+    };
+    for ( int i{ 1 }; i < argc; ++i ) {
+        const std::string_view current_args{ args[ i ] };
+        if ( current_args == "--help" ) {
+            show_help_info();
+            return EXIT_SUCCESS;
+        }
+        const std::string_view settings_name{ current_args.begin(), std::ranges::find( current_args, '=' ) + 1 };
+        if ( settings.contains( settings_name ) ) {
+            settings[ settings_name ] = current_args.substr( settings_name.size() );
+            continue;
+        }
+        std::print( error_info );
+        return EXIT_FAILURE;
+    }
+    std::vector< std::size_t > password_lengths;
+    std::vector< std::size_t > numbers_of_passwords;
+    std::vector< std::size_t > dictionaries;
+    std::vector< std::size_t > threads;
+    std::vector< std::size_t > min_duration_ms;
+    std::vector< std::string_view > rng_names;
+    for ( auto rest{ settings[ "--rngs=" ] }; !rest.empty(); ) {
+        const auto item{ rest.substr( 0, rest.find( ',' ) ) };
+        if ( item != "mt19937_64" && item != "chacha20" && item != "pool" ) {
+            std::print( error_info );
+            return EXIT_FAILURE;
+        }
+        rng_names.emplace_back( item );
+        rest.remove_prefix( std::ranges::min( item.size() + 1, rest.size() ) );
+    }
+    if ( !parse_list( settings[ "--password-lengths=" ], password_lengths )
+         || !parse_list( settings[ "--numbers-of-passwords=" ], numbers_of_passwords )
+         || !parse_list( settings[ "--dictionaries=" ], dictionaries ) || !parse_list( settings[ "--threads=" ], threads )
+         || !parse_list( settings[ "--min-duration-ms=" ], min_duration_ms ) || min_duration_ms.size() != 1
+         || rng_names.empty() || std::ranges::max( dictionaries ) > cpp_utils::character_class::all )
+    {
+        std::print( error_info );
+        return EXIT_FAILURE;
+    }
+#if defined( _WIN32 ) || defined( _WIN64 )
+    const auto null_stream{ std::fopen( "NUL", "wb" ) };
+#else
+    const auto null_stream{ std::fopen( "/dev/null", "wb" ) };
+#endif
+    const auto output_path{ settings[ "--output=" ] };
+    const auto report_stream{ output_path.empty() ? stdout : std::fopen( std::string{ output_path }.c_str(), "w" ) };
+    if ( null_stream == nullptr || report_stream == nullptr ) {
+        std::print( stderr, "Failed to open the output streams.\n" );
+        return EXIT_FAILURE;
+    }
+    const auto& features{ cpp_utils::get_cpu_features() };
+    std::print(
+      report_stream,
+      "{{\n"
+      "  \"cpu_features\": {{\"avx2\": {}, \"avx512f\": {}, \"avx512bw\": {}, \"avx512vbmi\": {}, \"avx512vbmi2\": {}}},\n"
+      "  \"min_duration_ms\": {},\n"
+      "  \"results\": [",
+      features.avx2, features.avx512f, features.avx512bw, features.avx512vbmi, features.avx512vbmi2,
+      min_duration_ms.front() );
+    const auto num_of_cases{
+      password_lengths.size() * numbers_of_passwords.size() * dictionaries.size() * rng_names.size() * threads.size() };
+    std::size_t case_index{ 0 };
+    for ( const auto rng_name : rng_names ) {
+        for ( const auto num_of_threads : threads ) {
+            for ( const auto classes : dictionaries ) {
+                for ( const auto password_length : password_lengths ) {
+                    for ( const auto num_of_passwords : numbers_of_passwords ) {
+                        const benchmark_case current{
+                          password_length, num_of_passwords, static_cast< unsigned >( classes ), rng_name, num_of_threads };
+                        std::print(
+                          stderr, "[{}/{}] rng={} threads={} dictionary={} length={} count={}\n", ++case_index,
+                          num_of_cases, rng_name, num_of_threads, classes, password_length, num_of_passwords );
+                        const auto result{
+                          run_case( current, std::chrono::milliseconds{ min_duration_ms.front() }, null_stream ) };
+                        if ( !result.has_value() ) {
+                            std::print( stderr, "Failed to collect entropy from the operating system.\n" );
+                            return EXIT_FAILURE;
+                        }
+                        std::print(
+                          report_stream,
+                          "{}\n    {{\"rng\": \"{}\", \"threads\": {}, \"dictionary\": {}, \"password_length\": {}, "
+                          "\"number_of_passwords\": {}, \"iterations\": {}, \"setup_ns\": {:.0f}, \"ns_per_password\": {:.3f}, "
+                          "\"bytes_per_second\": {:.0f}, \"allocations_per_password\": {:.6f}}}",
+                          case_index == 1 ? "" : ",", rng_name, num_of_threads, classes, password_length, num_of_passwords,
+                          result->iterations, result->setup_ns, result->ns_per_password, result->bytes_per_second,
+                          result->allocations_per_password );
+                    }
+                }
+            }
+        }
+    }
+    std::print( report_stream, "\n  ]\n}}\n" );
+    std::fclose( null_stream );
+    const auto is_written{
+      std::fflush( report_stream ) == 0 && std::ferror( report_stream ) == 0
+      && ( report_stream == stdout || std::fclose( report_stream ) == 0 ) };
+    if ( !is_written ) {
+        std::print( stderr, "Failed to write the JSON report.\n" );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file